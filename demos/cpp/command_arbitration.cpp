@@ -0,0 +1,131 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how several processes can command the same arm through a shared-memory
+// command mailbox, with the commands of the highest-priority fresh process applied at every tick.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following when run as "command_arbitration arbiter":
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Sets the modes to position and creates the mailbox /trossen_arm_command for 60 seconds
+// 4. The driver automatically sets the mode to idle at the destructor
+//
+// The script does the following when run as "command_arbitration planner" in another process:
+// 1. Claims source 0 with priority 0 and a timeout of 100 ms
+// 2. Moves the first joint back and forth for 30 seconds
+//
+// The script does the following when run as "command_arbitration safety" in a third process:
+// 1. Claims source 1 with priority 100 and a timeout of 100 ms
+// 2. Holds the arm at the home positions for 5 seconds, overriding the planner within one tick
+// 3. Releases the source, after which the planner is back in control
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_command_mailbox.hpp"
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+int run_arbiter() {
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  driver.set_all_modes(trossen_arm::Mode::position);
+
+  std::cout << "Arbitrating the commands from /trossen_arm_command..." << std::endl;
+  trossen_arm::StateMonitor monitor(driver);
+  // The sources run as the same user, and a mailbox left behind by a previous run that did not
+  // exit cleanly is replaced
+  trossen_arm::CommandArbiter arbiter(monitor, "/trossen_arm_command", 8, 0600, true);
+  for (int i = 0; i < 60; ++i) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::cout << "Active source: " << arbiter.get_active_source()
+              << ", rejected submissions: " << arbiter.get_rejections() << std::endl;
+  }
+
+  return 0;
+}
+
+int run_source(uint32_t source, int32_t priority, std::chrono::seconds duration, bool move) {
+  trossen_arm::CommandSource command_source(
+    "/trossen_arm_command",
+    source,
+    priority,
+    std::chrono::milliseconds(100)
+  );
+
+  std::vector<trossen_arm::JointCommand> commands(command_source.get_num_joints());
+  for (auto & command : commands) {
+    command.mode = trossen_arm::Mode::position;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < duration) {
+    if (move) {
+      float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+      commands[0].value = 0.5f * std::sin(0.5f * t);
+    }
+    command_source.submit(commands);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  std::string role = argc > 1 ? argv[1] : "";
+  if (role == "arbiter") {
+    return run_arbiter();
+  }
+  if (role == "planner") {
+    return run_source(0, 0, std::chrono::seconds(30), true);
+  }
+  if (role == "safety") {
+    return run_source(1, 100, std::chrono::seconds(5), false);
+  }
+  std::cerr << "Usage: " << argv[0] << " arbiter|planner|safety" << std::endl;
+  return 1;
+}
@@ -0,0 +1,97 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to execute chunks of commands, like the action chunks of a learned
+// policy, on the driver's clock with a command streamer.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following:
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Sets the modes to position
+// 4. Every 0.5 seconds for 10 seconds, submits a chunk of 50 steps of 20 ms moving the first joint
+//    along a sine wave, replacing the remainder of the previous chunk
+// 5. Moves the arm back to the home positions
+// 6. The driver automatically sets the mode to idle at the destructor
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_streaming.hpp"
+
+int main()
+{
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  driver.set_all_modes(trossen_arm::Mode::position);
+
+  const size_t num_joints = driver.get_num_joints();
+  const size_t num_steps = 50;
+  const std::chrono::milliseconds timestep(20);
+
+  trossen_arm::CommandStreamer streamer(driver);
+  streamer.start();
+
+  std::cout << "Streaming chunks..." << std::endl;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 20; ++i) {
+    // Compute a chunk starting now, as a policy would from the latest observation
+    auto origin = std::chrono::steady_clock::now();
+    float t0 = std::chrono::duration<float>(origin - start).count();
+    std::vector<float> chunk(num_steps * num_joints, 0.0f);
+    for (size_t step = 0; step < num_steps; ++step) {
+      float t = t0 + step * std::chrono::duration<float>(timestep).count();
+      chunk[step * num_joints] = 0.5f * std::sin(t);
+    }
+    streamer.submit(chunk, timestep, origin);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    std::cout << "Remaining steps of the chunk: " << streamer.get_remaining_steps() << std::endl;
+  }
+  streamer.stop();
+
+  std::cout << "Moving the arm back to the home positions..." << std::endl;
+  driver.set_all_positions(std::vector<float>(num_joints, 0.0f), 2.0f, true);
+
+  return 0;
+}
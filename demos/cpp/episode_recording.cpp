@@ -0,0 +1,132 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to record the states of several arms on a common clock together
+// with the timestamps of camera frames.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+// 2. A WXAI V0 arm with follower end effector and ip at 192.168.1.3
+//
+// The script does the following:
+// 1. Initializes the drivers
+// 2. Configures the drivers concurrently
+// 3. Starts gravity compensation on both arms
+// 4. Records the joint states of both arms every 2 ms to episode.taep for 10 seconds, marking
+//    the frames of a simulated 30 Hz camera
+// 5. Reads the episode back and prints a summary
+// 6. The driver automatically sets the mode to idle at the destructor
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_recorder.hpp"
+
+int main()
+{
+  std::cout << "Initializing the drivers..." << std::endl;
+  trossen_arm::TrossenArmDriver driver_leader;
+  trossen_arm::TrossenArmDriver driver_follower;
+
+  std::cout << "Configuring the drivers concurrently..." << std::endl;
+  std::vector<trossen_arm::GroupResult> results = trossen_arm::configure_all(
+    {&driver_leader, &driver_follower},
+    {
+      {
+        trossen_arm::Model::wxai_v0,
+        trossen_arm::StandardEndEffector::wxai_v0_leader,
+        "192.168.1.2",
+        false
+      },
+      {
+        trossen_arm::Model::wxai_v0,
+        trossen_arm::StandardEndEffector::wxai_v0_follower,
+        "192.168.1.3",
+        false
+      }
+    }
+  );
+  for (const trossen_arm::GroupResult & result : results) {
+    if (!result.success) {
+      std::cerr << "Failed to configure a driver: " << result.error << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "Starting gravity compensation..." << std::endl;
+  for (trossen_arm::TrossenArmDriver * driver : {&driver_leader, &driver_follower}) {
+    driver->set_all_modes(trossen_arm::Mode::external_effort);
+    driver->set_all_external_efforts(
+      std::vector<float>(driver->get_num_joints(), 0.0f),
+      0.0f,
+      false
+    );
+  }
+
+  std::cout << "Recording to episode.taep..." << std::endl;
+  trossen_arm::StateMonitor monitor_leader(driver_leader);
+  trossen_arm::StateMonitor monitor_follower(driver_follower);
+  {
+    trossen_arm::EpisodeRecorder recorder(
+      {&monitor_leader, &monitor_follower},
+      "episode.taep"
+    );
+    recorder.start();
+
+    // A camera thread marks every frame with its capture time
+    std::atomic<bool> capturing{true};
+    std::thread camera([&]() {
+        uint64_t frame = 0;
+        auto next = std::chrono::steady_clock::now();
+        while (capturing) {
+          recorder.mark(0, frame++, std::chrono::steady_clock::now());
+          next += std::chrono::microseconds(33333);
+          std::this_thread::sleep_until(next);
+        }
+      });
+
+    std::this_thread::sleep_for(std::chrono::seconds(10));
+    capturing = false;
+    camera.join();
+    recorder.stop();
+    std::cout << "Recorded " << recorder.get_rows() << " rows" << std::endl;
+  }
+
+  trossen_arm::EpisodeData episode = trossen_arm::read_episode("episode.taep");
+  std::cout << "Episode: " << episode.time.size() << " rows of " << episode.arms.size()
+            << " arms, " << episode.event_times.size() << " camera frames" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to apply, verify, or back up the persistent configurations of many
+// controllers concurrently.
+//
+// Hardware setup:
+// 1. Any number of WXAI V0 arms, listed in an inventory file like the following
+//
+//    arms:
+//      - ip: 192.168.1.2
+//        end_effector: leader
+//        config: leader_192_168_1_2.yaml
+//      - ip: 192.168.1.3
+//        end_effector: follower
+//        config: follower_192_168_1_3.yaml
+//
+//    where end_effector is one of base, leader, and follower, and every arm needs its own config
+//    file for backup
+//
+// The script does the following when run as "fleet_provisioning <apply|verify|backup> <inventory>
+// [max_parallel]":
+// 1. Loads and validates the inventory, rejecting duplicate IP addresses and, for backup,
+//    duplicate config files, and, for apply and verify, loads and validates every configuration
+//    file before any network traffic
+// 2. For every arm, with at most max_parallel arms at the same time, default 4:
+//    - apply: configures the driver and pushes only the configurations that differ
+//    - verify: configures the driver and compares the configurations with the file
+//    - backup: configures the driver and saves the configurations to the file
+// 3. Prints a summary per arm and the total wall time
+// 4. Power cycle the arms to apply the new configurations
+
+#include <arpa/inet.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_configuration.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+
+struct Arm
+{
+  std::string ip;
+  std::string end_effector;
+  std::string config;
+  trossen_arm::PersistentConfiguration configuration;
+  std::string detail;
+};
+
+std::string list_entries(const trossen_arm::PersistentConfiguration & configuration) {
+  std::string entries;
+  auto add = [&](bool set, const char * name) {
+      if (set) {
+        entries += (entries.empty() ? "" : ", ") + std::string(name);
+      }
+    };
+  add(configuration.factory_reset_flag.has_value(), "factory_reset_flag");
+  add(configuration.ip_method.has_value(), "ip_method");
+  add(configuration.manual_ip.has_value(), "manual_ip");
+  add(configuration.dns.has_value(), "dns");
+  add(configuration.gateway.has_value(), "gateway");
+  add(configuration.subnet.has_value(), "subnet");
+  add(configuration.joint_characteristics.has_value(), "joint_characteristics");
+  return entries.empty() ? "none" : entries;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <apply|verify|backup> <inventory> [max_parallel]"
+              << std::endl;
+    return 1;
+  }
+  std::string action = argv[1];
+  if (action != "apply" && action != "verify" && action != "backup") {
+    std::cerr << "Unknown action: " << action << std::endl;
+    return 1;
+  }
+  size_t max_parallel = 4;
+  if (argc > 3) {
+    std::string argument = argv[3];
+    size_t parsed = 0;
+    try {
+      max_parallel = std::stoul(argument, &parsed);
+    } catch (const std::exception &) {
+      parsed = 0;
+    }
+    if (parsed == 0 || parsed != argument.size() || argument[0] == '-' || max_parallel == 0) {
+      std::cerr << "Invalid max_parallel: expected a positive integer, got " << argument
+                << std::endl;
+      return 1;
+    }
+  }
+
+  // Load and validate everything before any network traffic
+  std::vector<Arm> arms;
+  try {
+    for (const YAML::Node & node : YAML::LoadFile(argv[2])["arms"]) {
+      Arm arm;
+      arm.ip = node["ip"].as<std::string>();
+      arm.end_effector = node["end_effector"].as<std::string>();
+      arm.config = node["config"].as<std::string>();
+      arms.push_back(arm);
+    }
+  } catch (const YAML::Exception & e) {
+    std::cerr << "Invalid inventory " << argv[2] << ": " << e.what() << std::endl;
+    return 1;
+  }
+  bool valid = true;
+  std::set<std::string> ips;
+  std::set<std::string> configs;
+  for (Arm & arm : arms) {
+    in_addr address{};
+    if (inet_pton(AF_INET, arm.ip.c_str(), &address) != 1) {
+      std::cerr << "Invalid IP address in the inventory: " << arm.ip << std::endl;
+      valid = false;
+    }
+    if (!ips.insert(arm.ip).second) {
+      std::cerr << "Duplicate IP address in the inventory: " << arm.ip << std::endl;
+      valid = false;
+    }
+    if (arm.end_effector != "base" && arm.end_effector != "leader" &&
+      arm.end_effector != "follower")
+    {
+      std::cerr << "Invalid end effector for " << arm.ip << ": expected base, leader, or "
+                << "follower, got " << arm.end_effector << std::endl;
+      valid = false;
+    }
+    if (action == "backup") {
+      // Backups run in parallel, so two arms sharing a file would overwrite each other
+      if (!configs.insert(arm.config).second) {
+        std::cerr << "Duplicate config file in the inventory: " << arm.config << std::endl;
+        valid = false;
+      }
+      continue;
+    }
+    try {
+      arm.configuration = trossen_arm::load_configuration_file(arm.config);
+    } catch (const std::exception & e) {
+      std::cerr << e.what() << std::endl;
+      valid = false;
+      continue;
+    }
+    // The joint count is checked against the controller in apply_configuration()
+    size_t num_joints = arm.configuration.joint_characteristics ?
+      arm.configuration.joint_characteristics->size() : 0;
+    for (const std::string & violation : trossen_arm::validate_configuration(
+        arm.configuration, static_cast<uint8_t>(num_joints)))
+    {
+      std::cerr << arm.config << ": " << violation << std::endl;
+      valid = false;
+    }
+  }
+  if (!valid) {
+    return 1;
+  }
+
+  std::cout << "Running " << action << " on " << arms.size() << " arms, at most " << max_parallel
+            << " at the same time..." << std::endl;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<trossen_arm::GroupResult> results = trossen_arm::run_parallel(
+    arms.size(),
+    max_parallel,
+    [&](size_t i) {
+      Arm & arm = arms[i];
+      trossen_arm::TrossenArmDriver driver;
+      trossen_arm::DriverConfiguration driver_configuration;
+      driver_configuration.serv_ip = arm.ip;
+      if (arm.end_effector == "leader") {
+        driver_configuration.end_effector = trossen_arm::StandardEndEffector::wxai_v0_leader;
+      } else if (arm.end_effector == "follower") {
+        driver_configuration.end_effector = trossen_arm::StandardEndEffector::wxai_v0_follower;
+      } else {
+        driver_configuration.end_effector = trossen_arm::StandardEndEffector::wxai_v0_base;
+      }
+      trossen_arm::apply_driver_configuration(driver, driver_configuration);
+
+      if (action == "apply") {
+        trossen_arm::PersistentConfiguration current = trossen_arm::read_configuration(driver);
+        trossen_arm::PersistentConfiguration diff =
+          trossen_arm::diff_configuration(arm.configuration, current);
+        trossen_arm::apply_configuration(driver, arm.configuration, current);
+        arm.detail = "pushed " + list_entries(diff);
+      } else if (action == "verify") {
+        trossen_arm::PersistentConfiguration diff = trossen_arm::diff_configuration(
+          arm.configuration, trossen_arm::read_configuration(driver));
+        if (list_entries(diff) != "none") {
+          throw std::runtime_error("mismatched " + list_entries(diff));
+        }
+        arm.detail = "matches";
+      } else {
+        trossen_arm::save_configuration_file(
+          arm.config, trossen_arm::read_configuration(driver));
+        arm.detail = "saved to " + arm.config;
+      }
+    }
+  );
+  double wall_time = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+
+  size_t num_failed = 0;
+  for (size_t i = 0; i < arms.size(); ++i) {
+    std::printf(
+      "%-15s  %-4s  %6.2f s  %s\n",
+      arms[i].ip.c_str(),
+      results[i].success ? "OK" : "FAIL",
+      results[i].duration,
+      results[i].success ? arms[i].detail.c_str() : results[i].error.c_str());
+    num_failed += results[i].success ? 0 : 1;
+  }
+  std::printf(
+    "%zu of %zu arms succeeded, total wall time %.2f s\n",
+    arms.size() - num_failed, arms.size(), wall_time);
+
+  return num_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how independent arm and gripper controllers can command the same robot
+// without contending with each other through per-group joint mailboxes.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following:
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Sets the modes to position
+// 4. For 10 seconds, an arm controller thread moves the first joint along a sine wave at 500 Hz
+//    while a gripper controller thread opens and closes the gripper at 10 Hz, both posting to
+//    their own mailbox
+// 5. Prints the number of driver calls saved by merging the posts
+// 6. The driver automatically sets the mode to idle at the destructor
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_joint_mailbox.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+int main()
+{
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  driver.set_all_modes(trossen_arm::Mode::position);
+
+  trossen_arm::StateMonitor monitor(driver);
+  trossen_arm::JointMailbox mailbox(monitor);
+  const size_t num_arm_joints = mailbox.get_groups()[0].size;
+
+  std::atomic<bool> running{true};
+  auto start = std::chrono::steady_clock::now();
+
+  std::thread arm_controller([&]() {
+      std::vector<trossen_arm::JointCommand> commands(num_arm_joints);
+      for (auto & command : commands) {
+        command.mode = trossen_arm::Mode::position;
+      }
+      while (running) {
+        float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        commands[0].value = 0.5f * std::sin(t);
+        commands[0].feedforward_velocity = 0.5f * std::cos(t);
+        mailbox.post(0, commands);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+    });
+
+  std::thread gripper_controller([&]() {
+      std::vector<trossen_arm::JointCommand> commands(1);
+      commands[0].mode = trossen_arm::Mode::position;
+      while (running) {
+        float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        commands[0].value = std::fmod(t, 2.0f) < 1.0f ? 0.04f : 0.0f;
+        mailbox.post(1, commands);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    });
+
+  std::this_thread::sleep_for(std::chrono::seconds(10));
+  running = false;
+  arm_controller.join();
+  gripper_controller.join();
+
+  std::cout << "Driver calls saved by merging: " << mailbox.get_merged_posts() << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to export the metrics of a driver for fleet dashboards.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following:
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Starts monitoring the states and collecting the metrics
+// 4. Serves the metrics at http://127.0.0.1:9100/metrics
+// 5. Prints the metrics every second while doing gravity compensation
+// 6. The driver automatically sets the mode to idle at the destructor
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_metrics.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+int main() {
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  std::cout << "Starting gravity compensation..." << std::endl;
+  driver.set_all_modes(trossen_arm::Mode::external_effort);
+  driver.set_all_external_efforts(
+    std::vector<float>(driver.get_num_joints(), 0.0f),
+    0.0f,
+    false
+  );
+
+  std::cout << "Serving the metrics at http://127.0.0.1:9100/metrics..." << std::endl;
+  trossen_arm::StateMonitor monitor(driver);
+  trossen_arm::MetricsCollector collector(monitor);
+  trossen_arm::MetricsServer server({{"192.168.1.2", &collector.get_metrics()}}, 9100);
+
+  for (int i = 0; i < 10; ++i) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::cout << trossen_arm::render_metrics({{"192.168.1.2", &collector.get_metrics()}});
+  }
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script measures the getter wake-up latency with the default scheduling and with the daemon
+// thread pinned to a dedicated core at a real-time priority.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following:
+// 1. Initializes the driver
+// 2. Configures the driver with the default scheduling
+// 3. Measures the getter wake-up latency, i.e., the duration of get_positions() calls, each waiting
+//    for the next cycle of the daemon thread
+// 4. Configures the driver with the daemon thread on CPU 2 at SCHED_FIFO priority 80
+// 5. Measures the getter wake-up latency again
+// 6. Prints the percentiles of both measurements
+// 7. The driver automatically sets the mode to idle at the destructor
+// NOTE: Real-time priorities require root or CAP_SYS_NICE
+// NOTE: The getter wake-up latency reflects the scheduling of the daemon thread and the caller, not
+//    the latency of the communication with the arm controller
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+#include "libtrossen_arm/trossen_arm_realtime.hpp"
+
+void measure(trossen_arm::TrossenArmDriver & driver, const char * label) {
+  const size_t num_samples = 10000;
+  std::vector<double> durations;
+  durations.reserve(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    driver.get_positions();
+    durations.push_back(
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  auto percentile = [&](double p) {
+    return durations[std::min(num_samples - 1, static_cast<size_t>(p * num_samples))];
+  };
+  std::printf(
+    "%-10s p50 %8.1f us  p99 %8.1f us  p99.9 %8.1f us  max %8.1f us\n",
+    label, percentile(0.5), percentile(0.99), percentile(0.999), durations.back());
+}
+
+int main() {
+  trossen_arm::DriverConfiguration configuration{
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  };
+
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver with the default scheduling..." << std::endl;
+  trossen_arm::apply_driver_configuration(driver, configuration);
+  measure(driver, "default");
+  driver.cleanup();
+
+  std::cout << "Configuring the driver with real-time scheduling..." << std::endl;
+  trossen_arm::RealtimeOptions options;
+  options.priority = 80;
+  options.cpus = {2};
+  trossen_arm::configure_realtime(driver, configuration, options);
+  measure(driver, "realtime");
+
+  return 0;
+}
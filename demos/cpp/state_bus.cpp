@@ -0,0 +1,129 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to share the arm state with other processes through a shared-memory
+// state bus.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following when run as "state_bus publish":
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Publishes the joint states and the commanded inputs to the shared memory /trossen_arm_state
+//    for 30 seconds while doing gravity compensation
+// 4. The driver automatically sets the mode to idle at the destructor
+//
+// The script does the following when run as "state_bus read" in other processes:
+// 1. Maps the shared memory /trossen_arm_state read-only
+// 2. Prints the latest positions and commanded external efforts every 100 ms for 10 seconds
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_state_bus.hpp"
+
+int publish_states() {
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  std::cout << "Starting gravity compensation..." << std::endl;
+  driver.set_all_modes(trossen_arm::Mode::external_effort);
+  driver.set_all_external_efforts(
+    std::vector<float>(driver.get_num_joints(), 0.0f),
+    0.0f,
+    false
+  );
+
+  std::cout << "Publishing the joint states to /trossen_arm_state..." << std::endl;
+  trossen_arm::StateMonitor monitor(driver);
+  // Replace a bus left behind by a previous run that did not exit cleanly
+  trossen_arm::StateBusPublisher publisher(monitor, "/trossen_arm_state", 1024, true);
+  // Publish the commands of the gravity compensation, which are not sent through a component that
+  // publishes them
+  std::vector<trossen_arm::JointCommand> commands(driver.get_num_joints());
+  for (trossen_arm::JointCommand & command : commands) {
+    command.mode = trossen_arm::Mode::external_effort;
+  }
+  publisher.publish_commands(commands);
+  std::this_thread::sleep_for(std::chrono::seconds(30));
+
+  return 0;
+}
+
+int read_states() {
+  trossen_arm::StateBusReader reader("/trossen_arm_state");
+  trossen_arm::JointStates states;
+  std::vector<trossen_arm::JointCommand> commands;
+  for (int i = 0; i < 100; ++i) {
+    if (reader.read_latest(states)) {
+      std::cout << "Sample " << states.sequence << " positions:";
+      for (float position : states.positions) {
+        std::cout << " " << position;
+      }
+      std::cout << std::endl;
+    }
+    if (reader.read_commands(commands)) {
+      std::cout << "Commanded external efforts:";
+      for (const trossen_arm::JointCommand & command : commands) {
+        std::cout << " " << command.value;
+      }
+      std::cout << std::endl;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  std::string role = argc > 1 ? argv[1] : "";
+  if (role == "publish") {
+    return publish_states();
+  }
+  if (role == "read") {
+    return read_states();
+  }
+  std::cerr << "Usage: " << argv[0] << " publish|read" << std::endl;
+  return 1;
+}
@@ -35,11 +35,12 @@
 //
 // The script does the following:
 // 1. Initializes the drivers
-// 2. Configures the drivers with the leader and follower configurations
+// 2. Configures the drivers with the leader and follower configurations concurrently
 // 3. Records the sleep positions
 // 4. Moves the robots to home positions
 // 5. For a specified amount of time, feeds the external efforts from the follower robot to the
-//    leader robot and feeds the positions from the leader robot to the follower robot
+//    leader robot and feeds the positions from the leader robot to the follower robot with the
+//    teleoperation engine, then reports the mirroring latency
 // 6. Moves the robots to home positions
 // 7. Moves the robots to sleep positions
 // 8. Sets the robots to idle mode
@@ -54,6 +55,8 @@
 #include <vector>
 
 #include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+#include "libtrossen_arm/trossen_arm_teleoperation.hpp"
 
 int main(int argc, char** argv)
 {
@@ -61,19 +64,30 @@ int main(int argc, char** argv)
   trossen_arm::TrossenArmDriver driver_leader;
   trossen_arm::TrossenArmDriver driver_follower;
 
-  std::cout << "Configuring the drivers..." << std::endl;
-  driver_leader.configure(
-    trossen_arm::Model::wxai_v0,
-    trossen_arm::StandardEndEffector::wxai_v0_leader,
-    "192.168.1.2",
-    false
-  );
-  driver_follower.configure(
-    trossen_arm::Model::wxai_v0,
-    trossen_arm::StandardEndEffector::wxai_v0_follower,
-    "192.168.1.3",
-    false
+  std::cout << "Configuring the drivers concurrently..." << std::endl;
+  std::vector<trossen_arm::GroupResult> results = trossen_arm::configure_all(
+    {&driver_leader, &driver_follower},
+    {
+      {
+        trossen_arm::Model::wxai_v0,
+        trossen_arm::StandardEndEffector::wxai_v0_leader,
+        "192.168.1.2",
+        false
+      },
+      {
+        trossen_arm::Model::wxai_v0,
+        trossen_arm::StandardEndEffector::wxai_v0_follower,
+        "192.168.1.3",
+        false
+      }
+    }
   );
+  for (const trossen_arm::GroupResult & result : results) {
+    if (!result.success) {
+      std::cerr << "Failed to configure a driver: " << result.error << std::endl;
+      return 1;
+    }
+  }
 
   std::cout << "Moving to home positions..." << std::endl;
   driver_leader.set_all_modes(trossen_arm::Mode::position);
@@ -91,32 +105,21 @@ int main(int argc, char** argv)
 
   std::cout << "Starting to teleoperate the robots..." << std::endl;
   std::this_thread::sleep_for(std::chrono::seconds(1));
-  driver_leader.set_all_modes(trossen_arm::Mode::external_effort);
-  driver_follower.set_all_modes(trossen_arm::Mode::position);
+  // The engine sets the leader to external_effort mode and the follower to position mode, then
+  // feeds the external efforts from the follower robot to the leader robot and the positions from
+  // the leader robot to the follower robot on a common tick
+  trossen_arm::TeleoperationPair pair;
+  pair.leader = &driver_leader;
+  pair.follower = &driver_follower;
+  pair.force_feedback_gains = std::vector<float>(driver_follower.get_num_joints(), 0.1f);
+  trossen_arm::TeleoperationEngine engine({pair});
+  engine.start();
+  std::this_thread::sleep_for(std::chrono::seconds(20));
+  engine.stop();
 
-  auto start_time = std::chrono::steady_clock::now();
-  auto end_time = start_time + std::chrono::seconds(20);
-  float force_feedback_gain = 0.1;
-  std::vector<float> external_efforts_leader(driver_leader.get_num_joints());
-  while (std::chrono::steady_clock::now() < end_time) {
-    // Feed the external external efforts from the follower robot to the leader robot
-    external_efforts_leader = driver_follower.get_external_efforts();
-    for (size_t i = 0; i < driver_leader.get_num_joints(); ++i) {
-      external_efforts_leader.at(i) *= -force_feedback_gain;
-    }
-    driver_leader.set_all_external_efforts(
-      external_efforts_leader,
-      0.0f,
-      false
-    );
-    // Feed the positions from the leader robot to the follower robot
-    driver_follower.set_all_positions(
-      driver_leader.get_positions(),
-      0.0f,
-      false,
-      driver_leader.get_velocities()
-    );
-  }
+  trossen_arm::TeleoperationLatency latency = engine.get_latency(0);
+  std::cout << "Mirroring latency: mean " << latency.mean * 1e3 << " ms, max "
+            << latency.max * 1e3 << " ms over " << latency.ticks << " ticks" << std::endl;
 
   std::cout << "Moving to home positions..." << std::endl;
   driver_leader.set_all_modes(trossen_arm::Mode::position);
@@ -0,0 +1,88 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Purpose:
+// This script demonstrates how to chain motions by waiting for the measured positions to converge
+// instead of sleeping for the goal time.
+//
+// Hardware setup:
+// 1. A WXAI V0 arm with leader end effector and ip at 192.168.1.2
+//
+// The script does the following:
+// 1. Initializes the driver
+// 2. Configures the driver
+// 3. Sets the modes to position
+// 4. Moves through a sequence of waypoints, starting each motion as soon as the previous one has
+//    converged, and prints the time each motion took
+// 5. The driver automatically sets the mode to idle at the destructor
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_motion.hpp"
+
+int main()
+{
+  std::cout << "Initializing the driver..." << std::endl;
+  trossen_arm::TrossenArmDriver driver;
+
+  std::cout << "Configuring the driver..." << std::endl;
+  driver.configure(
+    trossen_arm::Model::wxai_v0,
+    trossen_arm::StandardEndEffector::wxai_v0_leader,
+    "192.168.1.2",
+    false
+  );
+
+  driver.set_all_modes(trossen_arm::Mode::position);
+
+  trossen_arm::StateMonitor monitor(driver);
+  std::vector<std::vector<float>> waypoints{
+    {0.0, M_PI_2, M_PI_2, 0.0, 0.0, 0.0, 0.0},
+    {M_PI_4, M_PI_2, M_PI_2, 0.0, 0.0, 0.0, 0.04},
+    {-M_PI_4, M_PI_2, M_PI_2, 0.0, 0.0, 0.0, 0.0},
+    {0.0, M_PI_2, M_PI_2, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+  };
+
+  for (const std::vector<float> & waypoint : waypoints) {
+    auto start = std::chrono::steady_clock::now();
+    driver.set_all_positions(waypoint, 1.0f, false);
+    bool converged = trossen_arm::wait_until_done(monitor, waypoint, std::chrono::seconds(3));
+    double duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    std::cout << (converged ? "Converged" : "Timed out") << " after " << duration << " s"
+              << std::endl;
+  }
+
+  return 0;
+}
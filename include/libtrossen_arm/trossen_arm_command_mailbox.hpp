@@ -0,0 +1,595 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_COMMAND_MAILBOX_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_COMMAND_MAILBOX_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_state_bus.hpp"
+
+namespace trossen_arm
+{
+
+namespace detail
+{
+
+// Commands of a source as laid out in shared memory
+struct ShmSourceCommands
+{
+  int32_t priority;
+  int64_t timeout_ns;
+  ShmJointCommands commands;
+};
+
+// Mailbox slot of a source, owned by at most one process at a time
+struct alignas(64) ShmMailboxSlot
+{
+  // Ticket of the current claim, increasing with the claim order, 0 if the slot is free
+  std::atomic<uint64_t> claim;
+  // Time of the last claim or submission of the owner
+  std::atomic<int64_t> heartbeat_ns;
+  SeqlockSlot<ShmSourceCommands> commands;
+};
+
+// Header of a command mailbox, followed by the slots of the sources
+struct ShmMailboxHeader
+{
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t num_joints;
+  uint32_t num_sources;
+  alignas(64) std::atomic<int32_t> active_source;
+  std::atomic<uint64_t> last_claim;
+};
+
+// Magic number identifying a command mailbox
+constexpr uint32_t COMMAND_MAILBOX_MAGIC{0x5441434D};
+
+// Version of the command mailbox layout
+constexpr uint32_t COMMAND_MAILBOX_VERSION{2};
+
+// Time without heartbeat after which a claimed slot is considered abandoned
+constexpr std::chrono::seconds COMMAND_SOURCE_HEARTBEAT_TIMEOUT{1};
+
+}  // namespace detail
+
+/**
+ * @brief Arbiter of the commands submitted by several processes through a POSIX shared-memory
+ *   mailbox
+ *
+ * @details The mailbox holds one slot per command source, e.g., a planner, a teleoperation process,
+ *   and a safety stop. Every source writes its commands together with a priority and a staleness
+ *   timeout into its own slot, which is guarded by a sequence lock, so no lock is shared between
+ *   processes and a stalled source cannot block the others.
+ *
+ *   The arbiter subscribes to a state monitor and, for every sample, reads all slots and applies
+ *   the commands of the fresh source with the highest priority, the one that claimed its slot
+ *   first on a tie, so that control does not flip between equal sources with every submission. A
+ *   source is fresh while it owns its slot and its last commands are younger than its timeout.
+ *   Hence a higher-priority source takes over within one tick of its first submission, and control
+ *   falls back to the next source within one tick of its timeout or release. When the last fresh
+ *   source goes stale or releases its slot, the arbiter commands a safe hold once, i.e., the
+ *   current positions in the position mode and zero velocities or external efforts otherwise, so
+ *   the last commands of a crashed or stalled source do not stay active. While no source is fresh,
+ *   no further commands are applied.
+ *
+ *   Commands are validated before they compete: every joint must either be commanded in the mode
+ *   it had when the arbiter was constructed or be left untouched with the idle mode, and every
+ *   value must be finite. Commands failing the validation are skipped and counted.
+ *
+ *   The shared memory object /dev/shm/<name> is created by the arbiter, accessible to the owner
+ *   only by default, and removed at its destruction. Creation fails if the object already exists
+ *   unless replacing it is requested.
+ *
+ * @note The arbiter does not change the modes, construct a new arbiter after changing them
+ */
+class CommandArbiter
+{
+public:
+  /**
+   * @brief Construct the arbiter, create the mailbox, and subscribe to the state monitor
+   *
+   * @param monitor A state monitor, which must outlive the arbiter
+   * @param name Name of the shared memory object, starting with a slash, e.g., /trossen_arm_1_cmd
+   * @param num_sources Optional: number of source slots, default 8
+   * @param mode Optional: permissions of the shared memory object, default 0600, e.g., 0660 for
+   *   sources run by other users of the same group
+   * @param replace Optional: whether to remove an existing shared memory object of the same name
+   *   first, default false
+   * @param bus Optional: state bus publishing the applied commands, which must outlive the
+   *   arbiter, none by default
+   */
+  CommandArbiter(
+    StateMonitor & monitor,
+    const std::string & name,
+    uint32_t num_sources = 8,
+    mode_t mode = 0600,
+    bool replace = false,
+    StateBusPublisher * bus = nullptr)
+  : monitor_(monitor),
+    bus_(bus),
+    name_(name),
+    size_(sizeof(Header) + num_sources * sizeof(detail::ShmMailboxSlot)),
+    num_sources_(num_sources)
+  {
+    num_joints_ = monitor_.get_driver().get_num_joints();
+    if (num_joints_ == 0 || num_joints_ > detail::SHM_MAX_JOINTS) {
+      TALOG_FATAL(
+        "Invalid number of joints for the command mailbox: expected within [1, %d], got %d",
+        detail::SHM_MAX_JOINTS, num_joints_);
+    }
+    if (num_sources == 0) {
+      TALOG_FATAL("Invalid number of command sources: expected positive, got 0");
+    }
+    modes_ = monitor_.get_driver().get_modes();
+    if (replace) {
+      shm_unlink(name_.c_str());
+    }
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+    if (fd < 0) {
+      TALOG_FATAL("Failed to create the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    // The sources map the mailbox read-write, so apply the requested mode regardless of the umask
+    if (fchmod(fd, mode) < 0) {
+      close(fd);
+      shm_unlink(name_.c_str());
+      TALOG_FATAL(
+        "Failed to set the mode of the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    if (ftruncate(fd, size_) < 0) {
+      close(fd);
+      shm_unlink(name_.c_str());
+      TALOG_FATAL("Failed to size the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    void * address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+      shm_unlink(name_.c_str());
+      TALOG_FATAL("Failed to map the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    header_ = new (address) Header{};
+    header_->num_joints = num_joints_;
+    header_->num_sources = num_sources;
+    header_->version = detail::COMMAND_MAILBOX_VERSION;
+    header_->active_source.store(-1, std::memory_order_relaxed);
+    header_->last_claim.store(0, std::memory_order_relaxed);
+    slots_ = reinterpret_cast<detail::ShmMailboxSlot *>(header_ + 1);
+    for (uint32_t i = 0; i < num_sources; ++i) {
+      new (&slots_[i]) detail::ShmMailboxSlot{};
+    }
+    // Publish the magic last so that sources never see a partially initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic.store(detail::COMMAND_MAILBOX_MAGIC, std::memory_order_release);
+
+    commands_.resize(num_joints_);
+    subscription_ = monitor_.subscribe(
+      [this](const JointStates & states) {arbitrate(states);});
+  }
+
+  /// @brief Unsubscribe from the state monitor and remove the mailbox
+  ~CommandArbiter()
+  {
+    monitor_.unsubscribe(subscription_);
+    munmap(header_, size_);
+    shm_unlink(name_.c_str());
+  }
+
+  CommandArbiter(const CommandArbiter &) = delete;
+  CommandArbiter & operator=(const CommandArbiter &) = delete;
+
+  /**
+   * @brief Get the source whose commands were applied at the last tick
+   *
+   * @return Index of the source, -1 if no source was fresh
+   */
+  int get_active_source() const
+  {
+    return header_->active_source.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of times control passed to another source
+   *
+   * @return Number of switches, including to and from no source
+   */
+  uint64_t get_switches() const
+  {
+    return switches_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of submissions rejected by the validation
+   *
+   * @return Number of rejected submissions, counted once per tick
+   */
+  uint64_t get_rejections() const
+  {
+    return rejections_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // State monitor providing the ticks
+  StateMonitor & monitor_;
+
+  // State bus publishing the applied commands if any
+  StateBusPublisher * bus_;
+
+  // Name of the shared memory object
+  std::string name_;
+
+  // Size of the mapping in bytes
+  size_t size_;
+
+  using Header = detail::ShmMailboxHeader;
+
+  // Number of sources, never read back from the mapping, which the sources can write
+  uint32_t num_sources_;
+
+  // Number of joints
+  uint8_t num_joints_{0};
+
+  // Mapped header
+  Header * header_{nullptr};
+
+  // Mapped slots of the sources
+  detail::ShmMailboxSlot * slots_{nullptr};
+
+  // Modes of the joints at construction
+  std::vector<Mode> modes_;
+
+  // Commands of the winning source, reused across ticks
+  std::vector<JointCommand> commands_;
+
+  // Number of switches between sources
+  std::atomic<uint64_t> switches_{0};
+
+  // Number of rejected submissions
+  std::atomic<uint64_t> rejections_{0};
+
+  // Check that the commands match the configured modes and are finite
+  bool validate(const detail::ShmJointCommands & commands) const
+  {
+    for (size_t i = 0; i < num_joints_; ++i) {
+      if (commands.modes[i] == Mode::idle) {
+        continue;
+      }
+      if (commands.modes[i] != modes_[i] ||
+        !std::isfinite(commands.values[i]) ||
+        !std::isfinite(commands.feedforward_velocities[i]) ||
+        !std::isfinite(commands.feedforward_accelerations[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Identifier of the subscription to the state monitor
+  size_t subscription_{0};
+
+  // Pick the winning source and apply its commands, called on the monitor thread
+  void arbitrate(const JointStates & states)
+  {
+    int64_t now_ns = detail::to_ns(std::chrono::steady_clock::now());
+    int winner = -1;
+    uint64_t best_claim = 0;
+    detail::ShmSourceCommands best{};
+    detail::ShmSourceCommands data;
+    for (uint32_t i = 0; i < num_sources_; ++i) {
+      detail::ShmMailboxSlot & slot = slots_[i];
+      uint64_t claim = slot.claim.load(std::memory_order_acquire);
+      if (claim == 0) {
+        continue;
+      }
+      if (!detail::seqlock_read(slot.commands, data) || data.commands.sequence == 0) {
+        continue;
+      }
+      if (now_ns - data.commands.time_ns > data.timeout_ns) {
+        continue;
+      }
+      if (!validate(data.commands)) {
+        rejections_.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      if (winner < 0 || data.priority > best.priority ||
+        (data.priority == best.priority && claim < best_claim))
+      {
+        winner = static_cast<int>(i);
+        best_claim = claim;
+        best = data;
+      }
+    }
+
+    int previous = header_->active_source.load(std::memory_order_relaxed);
+    if (winner != previous) {
+      header_->active_source.store(winner, std::memory_order_relaxed);
+      switches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (winner < 0) {
+      if (previous >= 0) {
+        hold(states);
+      }
+      return;
+    }
+    for (size_t i = 0; i < num_joints_; ++i) {
+      commands_[i].mode = best.commands.modes[i];
+      commands_[i].value = best.commands.values[i];
+      commands_[i].feedforward_velocity = best.commands.feedforward_velocities[i];
+      commands_[i].feedforward_acceleration = best.commands.feedforward_accelerations[i];
+    }
+    apply_commands(monitor_.get_driver(), commands_);
+    if (bus_) {
+      bus_->publish_commands(commands_);
+    }
+  }
+
+  // Hold the current positions and stop any velocity or external effort
+  void hold(const JointStates & states)
+  {
+    for (size_t i = 0; i < num_joints_; ++i) {
+      commands_[i] = JointCommand{};
+      commands_[i].mode = modes_[i];
+      if (modes_[i] == Mode::position) {
+        commands_[i].value = states.positions[i];
+      }
+    }
+    apply_commands(monitor_.get_driver(), commands_);
+    if (bus_) {
+      bus_->publish_commands(commands_);
+    }
+  }
+};
+
+/**
+ * @brief Command source submitting commands to a command arbiter from another process
+ *
+ * @details The source claims its slot at construction and releases it at destruction. Every claim
+ *   and submission refreshes a heartbeat of the slot, and a slot whose heartbeat is older than a
+ *   second is considered abandoned, e.g., by a crashed process, and reclaimed. A source whose slot
+ *   was reclaimed fails at its next submission.
+ */
+class CommandSource
+{
+public:
+  /**
+   * @brief Construct the source, map the mailbox, and claim a slot
+   *
+   * @param name Name of the shared memory object given to the arbiter
+   * @param source Index of the slot in [0, number of sources - 1]
+   * @param priority Priority of the commands, higher wins
+   * @param timeout Time after which the last commands are stale and no longer applied
+   */
+  CommandSource(
+    const std::string & name,
+    uint32_t source,
+    int32_t priority,
+    std::chrono::nanoseconds timeout)
+  : source_(source),
+    priority_(priority),
+    timeout_ns_(timeout.count())
+  {
+    if (timeout_ns_ <= 0) {
+      TALOG_FATAL(
+        "Invalid command timeout: expected positive, got %lld ns",
+        static_cast<long long>(timeout_ns_));
+    }
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      TALOG_FATAL("Failed to open the shared memory %s: %s", name.c_str(), std::strerror(errno));
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0) {
+      int error = errno;
+      close(fd);
+      TALOG_FATAL("Failed to stat the shared memory %s: %s", name.c_str(), std::strerror(error));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void * address = size_ >= sizeof(Header) ?
+      mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (address == MAP_FAILED) {
+      TALOG_FATAL("Failed to map the shared memory %s", name.c_str());
+    }
+    header_ = static_cast<Header *>(address);
+    if (header_->magic.load(std::memory_order_acquire) != detail::COMMAND_MAILBOX_MAGIC ||
+      header_->version != detail::COMMAND_MAILBOX_VERSION)
+    {
+      munmap(header_, size_);
+      TALOG_FATAL("Shared memory %s is not a compatible command mailbox", name.c_str());
+    }
+    // Any process with write access can change the header, so validate it once against the
+    // mapping and never read the sizes from it again
+    num_sources_ = header_->num_sources;
+    num_joints_ = header_->num_joints;
+    if (num_joints_ == 0 || num_joints_ > detail::SHM_MAX_JOINTS || num_sources_ == 0 ||
+      size_ < sizeof(Header) + static_cast<size_t>(num_sources_) * sizeof(detail::ShmMailboxSlot))
+    {
+      munmap(header_, size_);
+      TALOG_FATAL(
+        "Shared memory %s has an inconsistent command mailbox: %u joints, %u sources, %zu bytes",
+        name.c_str(), num_joints_, num_sources_, size_);
+    }
+    if (source_ >= num_sources_) {
+      munmap(header_, size_);
+      TALOG_FATAL(
+        "Invalid command source: expected within [0, %u], got %u", num_sources_ - 1, source_);
+    }
+    slot_ = reinterpret_cast<detail::ShmMailboxSlot *>(header_ + 1) + source_;
+
+    claim_ = header_->last_claim.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t claim = slot_->claim.load(std::memory_order_acquire);
+    while (true) {
+      if (claim != 0) {
+        int64_t silence_ns = detail::to_ns(std::chrono::steady_clock::now()) -
+          slot_->heartbeat_ns.load(std::memory_order_acquire);
+        if (silence_ns <=
+          std::chrono::nanoseconds(detail::COMMAND_SOURCE_HEARTBEAT_TIMEOUT).count())
+        {
+          munmap(header_, size_);
+          TALOG_FATAL("Command source %u is claimed by another process", source_);
+        }
+      }
+      // Stamp the heartbeat before publishing the claim, so that a concurrent claimant never
+      // judges this claim by the heartbeat of the previous owner
+      heartbeat();
+      if (slot_->claim.compare_exchange_strong(claim, claim_, std::memory_order_acq_rel)) {
+        break;
+      }
+    }
+    // Clear the commands of the previous owner, which the arbiter must not apply for this source
+    detail::seqlock_write(slot_->commands, detail::ShmSourceCommands{});
+  }
+
+  /// @brief Release the slot unless it was reclaimed, and unmap the mailbox
+  ~CommandSource()
+  {
+    uint64_t claim = claim_;
+    slot_->claim.compare_exchange_strong(claim, 0, std::memory_order_acq_rel);
+    munmap(header_, size_);
+  }
+
+  CommandSource(const CommandSource &) = delete;
+  CommandSource & operator=(const CommandSource &) = delete;
+
+  /**
+   * @brief Get the number of joints
+   *
+   * @return Number of joints
+   */
+  uint8_t get_num_joints() const
+  {
+    return static_cast<uint8_t>(num_joints_);
+  }
+
+  /**
+   * @brief Submit commands
+   *
+   * @param commands Commands of all joints
+   *
+   * @note Only one thread may submit commands, and commands must be resubmitted faster than the
+   *   timeout to keep control and at least once a second to keep the slot
+   */
+  void submit(const std::vector<JointCommand> & commands)
+  {
+    if (commands.size() != get_num_joints()) {
+      TALOG_FATAL(
+        "Invalid commands size: expected %d, got %d",
+        get_num_joints(), static_cast<int>(commands.size()));
+    }
+    if (slot_->claim.load(std::memory_order_acquire) != claim_) {
+      TALOG_FATAL("Command source %u was reclaimed by another process", source_);
+    }
+    heartbeat();
+    detail::ShmSourceCommands data{};
+    data.priority = priority_;
+    data.timeout_ns = timeout_ns_;
+    data.commands.sequence = ++sequence_;
+    data.commands.time_ns = detail::to_ns(std::chrono::steady_clock::now());
+    for (size_t i = 0; i < commands.size(); ++i) {
+      data.commands.modes[i] = commands[i].mode;
+      data.commands.values[i] = commands[i].value;
+      data.commands.feedforward_velocities[i] = commands[i].feedforward_velocity;
+      data.commands.feedforward_accelerations[i] = commands[i].feedforward_acceleration;
+    }
+    detail::seqlock_write(slot_->commands, data);
+  }
+
+  /**
+   * @brief Check whether this source was in control at the last tick of the arbiter
+   *
+   * @return true The commands of this source were applied
+   * @return false Another source or no source was in control
+   */
+  bool is_active() const
+  {
+    return header_->active_source.load(std::memory_order_relaxed) ==
+           static_cast<int32_t>(source_);
+  }
+
+private:
+  using Header = detail::ShmMailboxHeader;
+
+  // Index of the slot
+  uint32_t source_;
+
+  // Priority of the commands
+  int32_t priority_;
+
+  // Staleness timeout of the commands in ns
+  int64_t timeout_ns_;
+
+  // Size of the mapping in bytes
+  size_t size_{0};
+
+  // Number of sources, validated against the size of the mapping
+  uint32_t num_sources_{0};
+
+  // Number of joints, validated against the capacity of the slots
+  uint32_t num_joints_{0};
+
+  // Mapped header
+  Header * header_{nullptr};
+
+  // Mapped slot of this source
+  detail::ShmMailboxSlot * slot_{nullptr};
+
+  // Ticket of the claim of this source
+  uint64_t claim_{0};
+
+  // Sequence number of the last submitted commands
+  uint64_t sequence_{0};
+
+  // Refresh the heartbeat of the slot
+  void heartbeat()
+  {
+    slot_->heartbeat_ns.store(
+      detail::to_ns(std::chrono::steady_clock::now()), std::memory_order_release);
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_COMMAND_MAILBOX_HPP_
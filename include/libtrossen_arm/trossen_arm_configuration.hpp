@@ -0,0 +1,422 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_CONFIGURATION_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_CONFIGURATION_HPP_
+
+#include <arpa/inet.h>
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/**
+ * @brief Persistent configurations of a controller
+ *
+ * @details Every configuration is optional, unset configurations are neither validated, compared,
+ *   nor pushed
+ */
+struct PersistentConfiguration
+{
+  /// @brief Whether to reset the configurations to factory defaults at the next startup
+  std::optional<bool> factory_reset_flag{};
+
+  /// @brief IP method
+  std::optional<IPMethod> ip_method{};
+
+  /// @brief Manual IP address
+  std::optional<std::string> manual_ip{};
+
+  /// @brief DNS address
+  std::optional<std::string> dns{};
+
+  /// @brief Gateway address
+  std::optional<std::string> gateway{};
+
+  /// @brief Subnet mask
+  std::optional<std::string> subnet{};
+
+  /// @brief Joint characteristics of all joints
+  std::optional<std::vector<JointCharacteristic>> joint_characteristics{};
+};
+
+namespace detail
+{
+
+// Whether two joint characteristics are identical
+inline bool joint_characteristic_equal(const JointCharacteristic & a, const JointCharacteristic & b)
+{
+  return a.effort_correction == b.effort_correction &&
+         a.friction_transition_velocity == b.friction_transition_velocity &&
+         a.friction_constant_term == b.friction_constant_term &&
+         a.friction_coulomb_coef == b.friction_coulomb_coef &&
+         a.friction_viscous_coef == b.friction_viscous_coef &&
+         a.continuity_factor == b.continuity_factor;
+}
+
+// Whether a string is a dotted-decimal IPv4 address
+inline bool is_ipv4(const std::string & address)
+{
+  in_addr addr{};
+  return inet_pton(AF_INET, address.c_str(), &addr) == 1;
+}
+
+// Whether a set target configuration differs from the current one
+template<typename T>
+bool changed(const std::optional<T> & target, const std::optional<T> & current)
+{
+  return target.has_value() && (!current.has_value() || *target != *current);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Load persistent configurations from a YAML file without any network traffic
+ *
+ * @param file_path The file path to load the configurations
+ * @return The configurations in the file
+ *
+ * @details The file has the layout written by TrossenArmDriver::save_configs_to_file(). Unknown
+ *   keys are skipped with a warning.
+ */
+inline PersistentConfiguration load_configuration_file(const std::string & file_path)
+{
+  YAML::Node node;
+  try {
+    node = YAML::LoadFile(file_path);
+  } catch (const YAML::Exception & e) {
+    TALOG_FATAL("Failed to load %s: %s", file_path.c_str(), e.what());
+  }
+  if (!node.IsMap()) {
+    TALOG_FATAL("Invalid configuration file %s: expected a map", file_path.c_str());
+  }
+
+  PersistentConfiguration configuration;
+  try {
+    for (const auto & entry : node) {
+      std::string key = entry.first.as<std::string>();
+      const YAML::Node & value = entry.second;
+      if (key == "factory_reset_flag") {
+        configuration.factory_reset_flag = value.as<bool>();
+      } else if (key == "ip_method") {
+        int ip_method = value.as<int>();
+        if (ip_method != static_cast<int>(IPMethod::manual) &&
+          ip_method != static_cast<int>(IPMethod::dhcp))
+        {
+          TALOG_FATAL(
+            "Invalid configuration file %s: ip_method must be %d (manual) or %d (dhcp), got %d",
+            file_path.c_str(), static_cast<int>(IPMethod::manual),
+            static_cast<int>(IPMethod::dhcp), ip_method);
+        }
+        configuration.ip_method = static_cast<IPMethod>(ip_method);
+      } else if (key == "manual_ip") {
+        configuration.manual_ip = value.as<std::string>();
+      } else if (key == "dns") {
+        configuration.dns = value.as<std::string>();
+      } else if (key == "gateway") {
+        configuration.gateway = value.as<std::string>();
+      } else if (key == "subnet") {
+        configuration.subnet = value.as<std::string>();
+      } else if (key == "joint_characteristics") {
+        std::vector<JointCharacteristic> joint_characteristics;
+        for (const YAML::Node & joint : value) {
+          JointCharacteristic joint_characteristic{};
+          joint_characteristic.effort_correction = joint["effort_correction"].as<float>();
+          joint_characteristic.friction_transition_velocity =
+            joint["friction_transition_velocity"].as<float>();
+          joint_characteristic.friction_constant_term =
+            joint["friction_constant_term"].as<float>();
+          joint_characteristic.friction_coulomb_coef = joint["friction_coulomb_coef"].as<float>();
+          joint_characteristic.friction_viscous_coef = joint["friction_viscous_coef"].as<float>();
+          joint_characteristic.continuity_factor = joint["continuity_factor"].as<float>();
+          joint_characteristics.push_back(joint_characteristic);
+        }
+        configuration.joint_characteristics = joint_characteristics;
+      } else {
+        TALOG_WARN("Skipping invalid/deprecated configuration key: %s", key.c_str());
+      }
+    }
+  } catch (const YAML::Exception & e) {
+    TALOG_FATAL("Invalid configuration file %s: %s", file_path.c_str(), e.what());
+  }
+  return configuration;
+}
+
+/**
+ * @brief Save persistent configurations to a YAML file without any network traffic
+ *
+ * @param file_path The file path to store the configurations
+ * @param configuration The configurations, only the set ones are saved
+ */
+inline void save_configuration_file(
+  const std::string & file_path,
+  const PersistentConfiguration & configuration)
+{
+  YAML::Emitter emitter;
+  emitter.SetFloatPrecision(9);
+  emitter << YAML::BeginMap;
+  if (configuration.factory_reset_flag) {
+    emitter << YAML::Key << "factory_reset_flag" << YAML::Value
+            << *configuration.factory_reset_flag;
+  }
+  if (configuration.ip_method) {
+    emitter << YAML::Key << "ip_method" << YAML::Value
+            << static_cast<int>(*configuration.ip_method);
+  }
+  auto emit_string = [&](const char * key, const std::optional<std::string> & value) {
+      if (value) {
+        emitter << YAML::Key << key << YAML::Value << *value;
+      }
+    };
+  emit_string("manual_ip", configuration.manual_ip);
+  emit_string("dns", configuration.dns);
+  emit_string("gateway", configuration.gateway);
+  emit_string("subnet", configuration.subnet);
+  if (configuration.joint_characteristics) {
+    emitter << YAML::Key << "joint_characteristics" << YAML::Value << YAML::BeginSeq;
+    for (const JointCharacteristic & joint : *configuration.joint_characteristics) {
+      emitter << YAML::BeginMap
+              << YAML::Key << "effort_correction" << YAML::Value << joint.effort_correction
+              << YAML::Key << "friction_transition_velocity"
+              << YAML::Value << joint.friction_transition_velocity
+              << YAML::Key << "friction_constant_term"
+              << YAML::Value << joint.friction_constant_term
+              << YAML::Key << "friction_coulomb_coef"
+              << YAML::Value << joint.friction_coulomb_coef
+              << YAML::Key << "friction_viscous_coef"
+              << YAML::Value << joint.friction_viscous_coef
+              << YAML::Key << "continuity_factor" << YAML::Value << joint.continuity_factor
+              << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+  }
+  emitter << YAML::EndMap;
+
+  std::ofstream file(file_path);
+  file << emitter.c_str() << std::endl;
+  if (!file) {
+    TALOG_FATAL("Failed to write %s", file_path.c_str());
+  }
+}
+
+/**
+ * @brief Validate persistent configurations without any network traffic
+ *
+ * @param configuration The configurations to validate
+ * @param num_joints The number of joints of the target controller
+ * @return Every violation found, empty if the configurations are valid
+ *
+ * @details The checks are the ones the driver setters apply: the IP method, the address formats,
+ *   the number of joint characteristics, and their ranges
+ */
+inline std::vector<std::string> validate_configuration(
+  const PersistentConfiguration & configuration,
+  uint8_t num_joints)
+{
+  std::vector<std::string> violations;
+  if (configuration.ip_method && *configuration.ip_method != IPMethod::manual &&
+    *configuration.ip_method != IPMethod::dhcp)
+  {
+    violations.push_back(
+      "IP method must be either manual: 0 or dhcp: 1, got " +
+      std::to_string(static_cast<int>(*configuration.ip_method)));
+  }
+  auto check_address = [&](const char * name, const std::optional<std::string> & address) {
+      if (address && !detail::is_ipv4(*address)) {
+        violations.push_back(std::string("Invalid ") + name + " address, got " + *address);
+      }
+    };
+  check_address("manual IP", configuration.manual_ip);
+  check_address("DNS", configuration.dns);
+  check_address("gateway", configuration.gateway);
+  check_address("subnet", configuration.subnet);
+  if (configuration.joint_characteristics) {
+    const std::vector<JointCharacteristic> & joints = *configuration.joint_characteristics;
+    if (joints.size() != num_joints) {
+      violations.push_back(
+        "Invalid joint characteristics size: expected " + std::to_string(num_joints) +
+        ", got " + std::to_string(joints.size()));
+    }
+    for (size_t i = 0; i < joints.size(); ++i) {
+      std::string joint = "joint " + std::to_string(i);
+      if (!(joints[i].effort_correction >= 0.5f && joints[i].effort_correction <= 2.0f)) {
+        violations.push_back(
+          "Invalid effort correction of " + joint + ": expected within [0.5, 2.0], got " +
+          std::to_string(joints[i].effort_correction));
+      }
+      if (!(joints[i].friction_transition_velocity > 0.0f)) {
+        violations.push_back(
+          "Invalid friction transition velocity of " + joint + ": expected positive, got " +
+          std::to_string(joints[i].friction_transition_velocity));
+      }
+      if (!(joints[i].continuity_factor >= 1.0f && joints[i].continuity_factor <= 10.0f)) {
+        violations.push_back(
+          "Invalid continuity factor of " + joint + ": expected within [1.0, 10.0], got " +
+          std::to_string(joints[i].continuity_factor));
+      }
+    }
+  }
+  return violations;
+}
+
+/**
+ * @brief Read the persistent configurations of a controller
+ *
+ * @param driver A configured driver
+ * @return The IP method, addresses, and joint characteristics, without the factory reset flag
+ */
+inline PersistentConfiguration read_configuration(TrossenArmDriver & driver)
+{
+  PersistentConfiguration configuration;
+  configuration.ip_method = driver.get_ip_method();
+  configuration.manual_ip = driver.get_manual_ip();
+  configuration.dns = driver.get_dns();
+  configuration.gateway = driver.get_gateway();
+  configuration.subnet = driver.get_subnet();
+  configuration.joint_characteristics = driver.get_joint_characteristics();
+  return configuration;
+}
+
+/**
+ * @brief Get the configurations of a target that differ from the current ones
+ *
+ * @param target The target configurations
+ * @param current The current configurations
+ * @return The set target configurations that are unset or different in the current ones
+ */
+inline PersistentConfiguration diff_configuration(
+  const PersistentConfiguration & target,
+  const PersistentConfiguration & current)
+{
+  PersistentConfiguration diff;
+  if (detail::changed(target.factory_reset_flag, current.factory_reset_flag)) {
+    diff.factory_reset_flag = target.factory_reset_flag;
+  }
+  if (detail::changed(target.ip_method, current.ip_method)) {
+    diff.ip_method = target.ip_method;
+  }
+  if (detail::changed(target.manual_ip, current.manual_ip)) {
+    diff.manual_ip = target.manual_ip;
+  }
+  if (detail::changed(target.dns, current.dns)) {
+    diff.dns = target.dns;
+  }
+  if (detail::changed(target.gateway, current.gateway)) {
+    diff.gateway = target.gateway;
+  }
+  if (detail::changed(target.subnet, current.subnet)) {
+    diff.subnet = target.subnet;
+  }
+  if (target.joint_characteristics) {
+    const std::vector<JointCharacteristic> & joints = *target.joint_characteristics;
+    bool equal = current.joint_characteristics &&
+      current.joint_characteristics->size() == joints.size();
+    for (size_t i = 0; equal && i < joints.size(); ++i) {
+      equal = detail::joint_characteristic_equal(joints[i], (*current.joint_characteristics)[i]);
+    }
+    if (!equal) {
+      diff.joint_characteristics = target.joint_characteristics;
+    }
+  }
+  return diff;
+}
+
+/**
+ * @brief Apply persistent configurations to a controller, pushing only the changed ones
+ *
+ * @param driver A configured driver
+ * @param target The target configurations
+ * @param current Optional: the current configurations, e.g., from a previous call or a backup,
+ *   read from the controller if not given
+ * @return The configurations of the controller after applying, to be passed as the current ones
+ *   next time
+ *
+ * @details The target is validated before any network traffic, and all violations are reported at
+ *   once. Then only the configurations differing from the current ones are pushed, one setter call
+ *   each. Like the setters, the new configurations take effect at the next power cycle.
+ */
+inline PersistentConfiguration apply_configuration(
+  TrossenArmDriver & driver,
+  const PersistentConfiguration & target,
+  std::optional<PersistentConfiguration> current = std::nullopt)
+{
+  std::vector<std::string> violations = validate_configuration(target, driver.get_num_joints());
+  if (!violations.empty()) {
+    std::string message;
+    for (const std::string & violation : violations) {
+      message += (message.empty() ? "" : "; ") + violation;
+    }
+    TALOG_FATAL("Invalid configurations: %s", message.c_str());
+  }
+
+  PersistentConfiguration result = current ? *current : read_configuration(driver);
+  PersistentConfiguration diff = diff_configuration(target, result);
+  if (diff.factory_reset_flag) {
+    driver.set_factory_reset_flag(*diff.factory_reset_flag);
+    result.factory_reset_flag = diff.factory_reset_flag;
+  }
+  if (diff.ip_method) {
+    driver.set_ip_method(*diff.ip_method);
+    result.ip_method = diff.ip_method;
+  }
+  if (diff.manual_ip) {
+    driver.set_manual_ip(*diff.manual_ip);
+    result.manual_ip = diff.manual_ip;
+  }
+  if (diff.dns) {
+    driver.set_dns(*diff.dns);
+    result.dns = diff.dns;
+  }
+  if (diff.gateway) {
+    driver.set_gateway(*diff.gateway);
+    result.gateway = diff.gateway;
+  }
+  if (diff.subnet) {
+    driver.set_subnet(*diff.subnet);
+    result.subnet = diff.subnet;
+  }
+  if (diff.joint_characteristics) {
+    driver.set_joint_characteristics(*diff.joint_characteristics);
+    result.joint_characteristics = diff.joint_characteristics;
+  }
+  return result;
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_CONFIGURATION_HPP_
@@ -0,0 +1,182 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_CONTROL_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_CONTROL_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Command of a joint, the public counterpart of the driver's joint input
+struct JointCommand
+{
+  /// @brief Mode of the command, which must match the configured mode, idle for no command
+  Mode mode{Mode::idle};
+
+  /// @brief Position in rad or m, velocity in rad/s or m/s, or external effort in Nm or N
+  /// depending on the mode
+  float value{0.0f};
+
+  /// @brief Feedforward velocity in rad/s or m/s, only used in the position mode
+  float feedforward_velocity{0.0f};
+
+  /// @brief Feedforward acceleration in rad/s^2 or m/s^2, used in the position and velocity modes
+  float feedforward_acceleration{0.0f};
+};
+
+namespace detail
+{
+
+// Apply the commands of the joints in [begin, end), which share the same mode, with the fewest
+// setter calls
+inline void apply_range(
+  TrossenArmDriver & driver,
+  const std::vector<JointCommand> & commands,
+  size_t begin,
+  size_t end,
+  float goal_time)
+{
+  size_t num_joints = commands.size();
+  bool all = begin == 0 && end == num_joints;
+  bool arm = begin == 0 && end == num_joints - 1;
+  bool gripper = begin == num_joints - 1 && end == num_joints;
+
+  std::vector<float> values;
+  std::vector<float> feedforward_velocities;
+  std::vector<float> feedforward_accelerations;
+  for (size_t i = begin; i < end; ++i) {
+    values.push_back(commands[i].value);
+    feedforward_velocities.push_back(commands[i].feedforward_velocity);
+    feedforward_accelerations.push_back(commands[i].feedforward_acceleration);
+  }
+
+  const JointCommand & first = commands[begin];
+  switch (first.mode) {
+    case Mode::idle:
+      break;
+    case Mode::position:
+      if (all) {
+        driver.set_all_positions(
+          values, goal_time, false, feedforward_velocities, feedforward_accelerations);
+      } else if (arm) {
+        driver.set_arm_positions(
+          values, goal_time, false, feedforward_velocities, feedforward_accelerations);
+      } else if (gripper) {
+        driver.set_gripper_position(
+          first.value, goal_time, false, first.feedforward_velocity,
+          first.feedforward_acceleration);
+      } else {
+        driver.set_joint_position(
+          static_cast<uint8_t>(begin), first.value, goal_time, false, first.feedforward_velocity,
+          first.feedforward_acceleration);
+      }
+      break;
+    case Mode::velocity:
+      if (all) {
+        driver.set_all_velocities(values, goal_time, false, feedforward_accelerations);
+      } else if (arm) {
+        driver.set_arm_velocities(values, goal_time, false, feedforward_accelerations);
+      } else if (gripper) {
+        driver.set_gripper_velocity(first.value, goal_time, false, first.feedforward_acceleration);
+      } else {
+        driver.set_joint_velocity(
+          static_cast<uint8_t>(begin), first.value, goal_time, false,
+          first.feedforward_acceleration);
+      }
+      break;
+    case Mode::external_effort:
+      if (all) {
+        driver.set_all_external_efforts(values, goal_time, false);
+      } else if (arm) {
+        driver.set_arm_external_efforts(values, goal_time, false);
+      } else if (gripper) {
+        driver.set_gripper_external_effort(first.value, goal_time, false);
+      } else {
+        driver.set_joint_external_effort(
+          static_cast<uint8_t>(begin), first.value, goal_time, false);
+      }
+      break;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Apply joint commands to a driver without blocking
+ *
+ * @param driver A configured driver
+ * @param commands Commands of all joints, joints with the idle mode are skipped
+ * @param goal_time Optional: goal time in s over which the driver interpolates from the current
+ *   commands, default 0.0f for immediate goals
+ *
+ * @details Since every setter call takes one communication cycle of the driver, a single call is
+ *   used if all joints share the same mode, two if only the gripper joint differs, and one per
+ *   joint otherwise.
+ */
+inline void apply_commands(
+  TrossenArmDriver & driver,
+  const std::vector<JointCommand> & commands,
+  float goal_time = 0.0f)
+{
+  size_t num_joints = commands.size();
+  if (num_joints == 0 || num_joints != driver.get_num_joints()) {
+    TALOG_FATAL(
+      "Invalid commands size: expected %d, got %d",
+      driver.get_num_joints(), static_cast<int>(num_joints));
+  }
+
+  auto uniform = [&](size_t begin, size_t end) {
+      for (size_t i = begin + 1; i < end; ++i) {
+        if (commands[i].mode != commands[begin].mode) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+  if (uniform(0, num_joints)) {
+    detail::apply_range(driver, commands, 0, num_joints, goal_time);
+  } else if (uniform(0, num_joints - 1)) {
+    detail::apply_range(driver, commands, 0, num_joints - 1, goal_time);
+    detail::apply_range(driver, commands, num_joints - 1, num_joints, goal_time);
+  } else {
+    for (size_t i = 0; i < num_joints; ++i) {
+      detail::apply_range(driver, commands, i, i + 1, goal_time);
+    }
+  }
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_CONTROL_HPP_
@@ -0,0 +1,183 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_GROUP_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_GROUP_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Arguments of TrossenArmDriver::configure()
+struct DriverConfiguration
+{
+  /// @brief Model of the robot
+  Model model{Model::wxai_v0};
+
+  /// @brief End effector properties
+  EndEffectorProperties end_effector{StandardEndEffector::wxai_v0_base};
+
+  /// @brief IP address of the robot
+  std::string serv_ip{"192.168.1.2"};
+
+  /// @brief Whether to clear the error state of the robot
+  bool clear_error{false};
+};
+
+/// @brief Result of an operation on one arm of a group
+struct GroupResult
+{
+  /// @brief Whether the operation succeeded
+  bool success{false};
+
+  /// @brief Error message if the operation failed
+  std::string error{};
+
+  /// @brief Time in s taken by the operation
+  double duration{0.0};
+};
+
+/**
+ * @brief Run a job for every index concurrently with bounded parallelism
+ *
+ * @param count Number of jobs
+ * @param max_parallel Maximum number of jobs running at the same time, unlimited if 0
+ * @param job Job taking the index in [0, count - 1]
+ * @return Results of the jobs, a job fails if it throws
+ */
+inline std::vector<GroupResult> run_parallel(
+  size_t count,
+  size_t max_parallel,
+  const std::function<void(size_t)> & job)
+{
+  std::vector<GroupResult> results(count);
+  std::atomic<size_t> next{0};
+  auto worker = [&] {
+      for (size_t i = next++; i < count; i = next++) {
+        auto start = std::chrono::steady_clock::now();
+        try {
+          job(i);
+          results[i].success = true;
+        } catch (const std::exception & e) {
+          results[i].error = e.what();
+        } catch (...) {
+          results[i].error = "Unknown exception";
+        }
+        results[i].duration = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+      }
+    };
+
+  size_t num_workers = max_parallel == 0 ? count : std::min(count, max_parallel);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers.emplace_back(worker);
+  }
+  for (std::thread & thread : workers) {
+    thread.join();
+  }
+  return results;
+}
+
+/**
+ * @brief Configure a driver with a driver configuration
+ *
+ * @param driver The driver to configure
+ * @param configuration The configuration
+ */
+inline void apply_driver_configuration(
+  TrossenArmDriver & driver,
+  const DriverConfiguration & configuration)
+{
+  driver.configure(
+    configuration.model,
+    configuration.end_effector,
+    configuration.serv_ip,
+    configuration.clear_error);
+}
+
+/**
+ * @brief Configure a group of drivers concurrently
+ *
+ * @param drivers The drivers to configure
+ * @param configurations The configurations of the drivers
+ * @param deadline Optional: time allowed for the whole group, no deadline if not given
+ * @param max_parallel Optional: maximum number of drivers configured at the same time, unlimited
+ *   if 0
+ * @return Results of the drivers
+ *
+ * @details The handshakes and configuration round trips of the drivers overlap, so the startup time
+ *   of the group scales with the slowest arm instead of the sum of all arms.
+ *
+ *   A configuration in progress cannot be interrupted, so all configurations run to completion.
+ *   Drivers that finish after the deadline are cleaned up and reported as failed.
+ */
+inline std::vector<GroupResult> configure_all(
+  const std::vector<TrossenArmDriver *> & drivers,
+  const std::vector<DriverConfiguration> & configurations,
+  std::optional<std::chrono::milliseconds> deadline = std::nullopt,
+  size_t max_parallel = 0)
+{
+  if (drivers.size() != configurations.size()) {
+    TALOG_FATAL(
+      "Invalid configurations size: expected %d, got %d",
+      static_cast<int>(drivers.size()), static_cast<int>(configurations.size()));
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::vector<GroupResult> results = run_parallel(
+    drivers.size(), max_parallel,
+    [&](size_t i) {
+      apply_driver_configuration(*drivers[i], configurations[i]);
+      if (deadline && std::chrono::steady_clock::now() - start > *deadline) {
+        drivers[i]->cleanup();
+        TALOG_ERROR(
+          "Configuring %s missed the deadline of %d ms",
+          configurations[i].serv_ip.c_str(), static_cast<int>(deadline->count()));
+        throw std::runtime_error("Deadline exceeded");
+      }
+    });
+  return results;
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_GROUP_HPP_
@@ -0,0 +1,277 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_JOINT_MAILBOX_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_JOINT_MAILBOX_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_state_bus.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Contiguous range of joints commanded by one controller
+struct JointGroup
+{
+  /// @brief Index of the first joint
+  uint8_t first{0};
+
+  /// @brief Number of joints
+  uint8_t size{0};
+};
+
+namespace detail
+{
+
+// Commands of a joint group as posted to its mailbox
+struct GroupCommands
+{
+  uint64_t sequence;
+  float goal_time;
+  JointCommand commands[SHM_MAX_JOINTS];
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lock-free per-group command mailboxes
+ *
+ * @details Every joint group, by default the arm joints and the gripper joint, has its own mailbox
+ *   guarded by a sequence lock. A controller posts the commands of its group without waiting, so
+ *   controllers of different groups, e.g., an arm controller and a gripper controller, never
+ *   contend with each other or with the driver.
+ *
+ *   The mailboxes subscribe to a state monitor and, for every sample after any post, merge the new
+ *   posts sharing the same goal time and apply them with a single driver call if the modes allow,
+ *   instead of one call per controller. Only the joints of the groups that posted are commanded,
+ *   the other joints are left idle in that call, so a group that did not post keeps interpolating
+ *   towards its own last goal instead of having stale commands replayed.
+ *
+ * @note Only one thread may post to a group at a time
+ */
+class JointMailbox
+{
+public:
+  /**
+   * @brief Construct the mailboxes and subscribe to the state monitor
+   *
+   * @param monitor A state monitor of a configured driver, which must outlive the mailboxes
+   * @param groups Optional: disjoint joint groups, the arm joints and the gripper joint if empty
+   * @param bus Optional: state bus publishing the applied commands, which must outlive the
+   *   mailboxes, none by default
+   */
+  explicit JointMailbox(
+    StateMonitor & monitor,
+    std::vector<JointGroup> groups = {},
+    StateBusPublisher * bus = nullptr)
+  : monitor_(monitor),
+    bus_(bus),
+    groups_(std::move(groups))
+  {
+    TrossenArmDriver & driver = monitor_.get_driver();
+    uint8_t num_joints = driver.get_num_joints();
+    if (num_joints == 0 || num_joints > detail::SHM_MAX_JOINTS) {
+      TALOG_FATAL(
+        "Invalid number of joints for the joint mailboxes: expected within [1, %d], got %d",
+        detail::SHM_MAX_JOINTS, num_joints);
+    }
+    if (groups_.empty() && num_joints == 1) {
+      groups_.push_back({0, 1});
+    } else if (groups_.empty()) {
+      groups_.push_back({0, static_cast<uint8_t>(num_joints - 1)});
+      groups_.push_back({static_cast<uint8_t>(num_joints - 1), 1});
+    }
+    std::vector<bool> covered(num_joints, false);
+    for (const JointGroup & group : groups_) {
+      if (group.size == 0 || group.first + group.size > num_joints) {
+        TALOG_FATAL(
+          "Invalid joint group: expected within [0, %d], got [%d, %d]",
+          num_joints - 1, group.first, group.first + group.size - 1);
+      }
+      for (uint8_t i = group.first; i < group.first + group.size; ++i) {
+        if (covered[i]) {
+          TALOG_FATAL("Invalid joint groups: joint %d is in more than one group", i);
+        }
+        covered[i] = true;
+      }
+    }
+
+    commands_.resize(num_joints);
+    slots_ = std::make_unique<detail::SeqlockSlot<detail::GroupCommands>[]>(groups_.size());
+    sequences_ = std::make_unique<uint64_t[]>(groups_.size());
+    posts_.resize(groups_.size());
+    pending_.resize(groups_.size(), false);
+    for (size_t i = 0; i < groups_.size(); ++i) {
+      slots_[i].seq.store(0, std::memory_order_relaxed);
+      slots_[i].data.sequence = 0;
+      sequences_[i] = 0;
+    }
+
+    subscription_ = monitor_.subscribe(
+      [this](const JointStates & states) {dispatch(states);});
+  }
+
+  /// @brief Unsubscribe from the state monitor and destroy the mailboxes
+  ~JointMailbox()
+  {
+    monitor_.unsubscribe(subscription_);
+  }
+
+  JointMailbox(const JointMailbox &) = delete;
+  JointMailbox & operator=(const JointMailbox &) = delete;
+
+  /**
+   * @brief Get the joint groups
+   *
+   * @return The joint groups, indexed as in post()
+   */
+  const std::vector<JointGroup> & get_groups() const
+  {
+    return groups_;
+  }
+
+  /**
+   * @brief Post the commands of a group without waiting
+   *
+   * @param group Index of the group, 0 for the arm and 1 for the gripper by default
+   * @param commands Commands of the joints of the group, whose modes must match the configured
+   *   modes
+   * @param goal_time Optional: goal time in s over which the driver interpolates from the current
+   *   commands, default 0.0f for immediate goals
+   */
+  void post(size_t group, const std::vector<JointCommand> & commands, float goal_time = 0.0f)
+  {
+    const JointGroup & joint_group = groups_.at(group);
+    if (commands.size() != joint_group.size) {
+      TALOG_FATAL(
+        "Invalid commands size: expected %d, got %d",
+        joint_group.size, static_cast<int>(commands.size()));
+    }
+    if (!(goal_time >= 0.0f)) {
+      TALOG_FATAL("Invalid goal time: expected non-negative, got %f", goal_time);
+    }
+    detail::SeqlockSlot<detail::GroupCommands> & slot = slots_[group];
+    detail::GroupCommands data;
+    data.sequence = slot.data.sequence + 1;
+    data.goal_time = goal_time;
+    std::copy(commands.begin(), commands.end(), data.commands);
+    detail::seqlock_write(slot, data);
+  }
+
+  /**
+   * @brief Get the number of driver calls saved by merging the groups
+   *
+   * @return Number of group posts applied minus the number of driver calls applying them
+   */
+  uint64_t get_merged_posts() const
+  {
+    return merged_posts_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // State monitor providing the ticks
+  StateMonitor & monitor_;
+
+  // State bus publishing the applied commands if any
+  StateBusPublisher * bus_;
+
+  // Joint groups
+  std::vector<JointGroup> groups_;
+
+  // Mailboxes of the groups
+  std::unique_ptr<detail::SeqlockSlot<detail::GroupCommands>[]> slots_;
+
+  // Sequence numbers of the last applied posts of the groups
+  std::unique_ptr<uint64_t[]> sequences_;
+
+  // New posts of the groups read at the current tick
+  std::vector<detail::GroupCommands> posts_;
+
+  // Whether the post of a group read at the current tick is still to be applied
+  std::vector<bool> pending_;
+
+  // Merged commands of all joints, idle for the joints not commanded
+  std::vector<JointCommand> commands_;
+
+  // Number of driver calls saved by merging
+  std::atomic<uint64_t> merged_posts_{0};
+
+  // Identifier of the subscription to the state monitor
+  size_t subscription_{0};
+
+  // Merge the new posts and apply them, called on the monitor thread
+  void dispatch(const JointStates &)
+  {
+    size_t num_new = 0;
+    for (size_t i = 0; i < groups_.size(); ++i) {
+      pending_[i] = detail::seqlock_read(slots_[i], posts_[i]) &&
+        posts_[i].sequence != sequences_[i];
+      if (pending_[i]) {
+        sequences_[i] = posts_[i].sequence;
+        ++num_new;
+      }
+    }
+
+    // Apply the posts in batches sharing the same goal time
+    size_t num_calls = 0;
+    for (size_t first = 0; first < groups_.size(); ++first) {
+      if (!pending_[first]) {
+        continue;
+      }
+      float goal_time = posts_[first].goal_time;
+      std::fill(commands_.begin(), commands_.end(), JointCommand{});
+      for (size_t i = first; i < groups_.size(); ++i) {
+        if (pending_[i] && posts_[i].goal_time == goal_time) {
+          std::copy_n(posts_[i].commands, groups_[i].size, commands_.begin() + groups_[i].first);
+          pending_[i] = false;
+        }
+      }
+      apply_commands(monitor_.get_driver(), commands_, goal_time);
+      if (bus_) {
+        bus_->publish_commands(commands_);
+      }
+      ++num_calls;
+    }
+    merged_posts_.fetch_add(num_new - num_calls, std::memory_order_relaxed);
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_JOINT_MAILBOX_HPP_
@@ -33,19 +33,48 @@
 #include <cstdio>
 #include <string>
 
+// Minimum level compiled in, calls below it are stripped entirely
+// 0: DEBUG, 1: INFO, 2: WARN, 3: ERROR, FATAL is never stripped
+#ifndef TALOG_MIN_LEVEL
+#define TALOG_MIN_LEVEL 0
+#endif
+
+// Backend for non-fatal levels, FATAL always logs synchronously since it throws
+#ifdef TROSSEN_ARM_ASYNC_LOGGING
+#define TALOG_BACKEND trossen_arm::logging::log_async
+#else
+#define TALOG_BACKEND trossen_arm::logging::log
+#endif
+
 // define logging macros
-#define TALOG_DEBUG(...) trossen_arm::logging::log( \
+#if TALOG_MIN_LEVEL <= 0
+#define TALOG_DEBUG(...) TALOG_BACKEND( \
     trossen_arm::logging::Level::DEBUG, \
     __VA_ARGS__)
-#define TALOG_INFO(...) trossen_arm::logging::log( \
+#else
+#define TALOG_DEBUG(...) static_cast<void>(0)
+#endif
+#if TALOG_MIN_LEVEL <= 1
+#define TALOG_INFO(...) TALOG_BACKEND( \
     trossen_arm::logging::Level::INFO, \
     __VA_ARGS__)
-#define TALOG_WARN(...) trossen_arm::logging::log( \
+#else
+#define TALOG_INFO(...) static_cast<void>(0)
+#endif
+#if TALOG_MIN_LEVEL <= 2
+#define TALOG_WARN(...) TALOG_BACKEND( \
     trossen_arm::logging::Level::WARN, \
     __VA_ARGS__)
-#define TALOG_ERROR(...) trossen_arm::logging::log( \
+#else
+#define TALOG_WARN(...) static_cast<void>(0)
+#endif
+#if TALOG_MIN_LEVEL <= 3
+#define TALOG_ERROR(...) TALOG_BACKEND( \
     trossen_arm::logging::Level::ERROR, \
     __VA_ARGS__)
+#else
+#define TALOG_ERROR(...) static_cast<void>(0)
+#endif
 #define TALOG_FATAL(...) trossen_arm::logging::log( \
     trossen_arm::logging::Level::FATAL, \
     __VA_ARGS__)
@@ -65,9 +94,6 @@ enum Level
   FATAL = 4
 };
 
-// The logging level - anything higher than this level will be logged
-static Level _level = Level::INFO;
-
 /**
  * @brief Log a message
  * @param level The level with which to log the message
@@ -97,5 +123,8 @@ Level get_level();
 
 }  // namespace trossen_arm
 
+#ifdef TROSSEN_ARM_ASYNC_LOGGING
+#include "libtrossen_arm/trossen_arm_logging_async.hpp"
+#endif
 
 #endif  // LIBTROSSEN_ARM__TROSSEN_ARM_LOGGING_HPP_
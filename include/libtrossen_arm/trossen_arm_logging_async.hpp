@@ -0,0 +1,580 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_LOGGING_ASYNC_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_LOGGING_ASYNC_HPP_
+
+#include <syslog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+namespace logging
+{
+
+namespace detail
+{
+
+// Maximum size of a string argument copied into a queue cell, including the terminator
+constexpr size_t ASYNC_STRING_SIZE{128};
+
+// Inline copy of a string argument, truncated to fit
+struct AsyncString
+{
+  char data[ASYNC_STRING_SIZE];
+};
+
+inline AsyncString copy_string(const char * value, size_t size)
+{
+  AsyncString string;
+  size = std::min(size, ASYNC_STRING_SIZE - 1);
+  std::memcpy(string.data, value, size);
+  string.data[size] = '\0';
+  return string;
+}
+
+// Convert an argument into the form stored in a queue cell, copying strings since their storage
+// may not outlive the formatting on the background thread
+template<typename T>
+T to_stored(T value)
+{
+  return value;
+}
+
+inline AsyncString to_stored(const char * value)
+{
+  if (value == nullptr) {
+    return copy_string("(null)", 6);
+  }
+  return copy_string(value, std::strlen(value));
+}
+
+inline AsyncString to_stored(char * value)
+{
+  return to_stored(static_cast<const char *>(value));
+}
+
+inline AsyncString to_stored(const std::string & value)
+{
+  return copy_string(value.data(), value.size());
+}
+
+template<typename T>
+using Stored = decltype(to_stored(std::declval<T>()));
+
+// Convert a stored argument back into a printf argument
+template<typename T>
+T to_argument(T value)
+{
+  return value;
+}
+
+inline const char * to_argument(const AsyncString & value)
+{
+  return value.data;
+}
+
+}  // namespace detail
+
+/// @brief A formatted log entry delivered to the sinks
+struct Entry
+{
+  /// @brief Level of the entry
+  Level level;
+  /// @brief Time at which the entry was logged
+  std::chrono::system_clock::time_point time;
+  /// @brief Formatted message
+  std::string message;
+};
+
+/// @brief Sink receiving the formatted log entries on the background thread
+class Sink
+{
+public:
+  virtual ~Sink() = default;
+
+  /**
+   * @brief Write an entry
+   *
+   * @param entry The formatted log entry
+   */
+  virtual void write(const Entry & entry) = 0;
+
+  /// @brief Flush the buffered entries if any
+  virtual void flush() {}
+};
+
+/// @brief Sink writing to a C stream in the format of the synchronous logger
+class StreamSink : public Sink
+{
+public:
+  /**
+   * @brief Construct the stream sink
+   *
+   * @param stream The stream to write to, which is not closed by the sink
+   */
+  explicit StreamSink(FILE * stream = stdout)
+  : stream_(stream)
+  {
+  }
+
+  void write(const Entry & entry) override
+  {
+    static constexpr const char * LEVEL_NAME[] = {
+      "[DEBUG] ", "[INFO] ", "[WARN] ", "[ERROR] ", "[FATAL] "};
+    std::fprintf(stream_, "%s[trossen_arm] %s\n", LEVEL_NAME[entry.level], entry.message.c_str());
+  }
+
+  void flush() override
+  {
+    std::fflush(stream_);
+  }
+
+protected:
+  // Stream to write to
+  FILE * stream_;
+};
+
+/// @brief Sink appending timestamped entries to a file
+class FileSink : public StreamSink
+{
+public:
+  /**
+   * @brief Construct the file sink
+   *
+   * @param file_path The file path to append the entries to
+   */
+  explicit FileSink(const std::string & file_path)
+  : StreamSink(std::fopen(file_path.c_str(), "a"))
+  {
+    if (stream_ == nullptr) {
+      log(Level::FATAL, "Failed to open file %s", file_path.c_str());
+    }
+  }
+
+  ~FileSink() override
+  {
+    if (stream_ != nullptr) {
+      std::fclose(stream_);
+    }
+  }
+
+  void write(const Entry & entry) override
+  {
+    auto seconds = std::chrono::system_clock::to_time_t(entry.time);
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+      entry.time.time_since_epoch()).count() % 1000000;
+    std::tm tm{};
+    localtime_r(&seconds, &tm);
+    char time[32];
+    std::strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", &tm);
+    std::fprintf(stream_, "%s.%06ld ", time, static_cast<long>(microseconds));
+    StreamSink::write(entry);
+  }
+};
+
+/// @brief Sink forwarding the entries to syslog
+class SyslogSink : public Sink
+{
+public:
+  /**
+   * @brief Construct the syslog sink
+   *
+   * @param ident Identifier prepended to every message
+   */
+  explicit SyslogSink(const std::string & ident = "trossen_arm")
+  : ident_(ident)
+  {
+    openlog(ident_.c_str(), LOG_PID, LOG_USER);
+  }
+
+  ~SyslogSink() override
+  {
+    closelog();
+  }
+
+  void write(const Entry & entry) override
+  {
+    static constexpr int PRIORITY[] = {LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERR, LOG_CRIT};
+    syslog(PRIORITY[entry.level], "%s", entry.message.c_str());
+  }
+
+private:
+  // Identifier, which must outlive the syslog connection
+  std::string ident_;
+};
+
+/// @brief Sink invoking a user callback
+class CallbackSink : public Sink
+{
+public:
+  /**
+   * @brief Construct the callback sink
+   *
+   * @param callback Callback invoked on the background thread for every entry
+   */
+  explicit CallbackSink(std::function<void(const Entry &)> callback)
+  : callback_(std::move(callback))
+  {
+  }
+
+  void write(const Entry & entry) override
+  {
+    callback_(entry);
+  }
+
+private:
+  // Callback
+  std::function<void(const Entry &)> callback_;
+};
+
+/**
+ * @brief Asynchronous logger
+ *
+ * @details Producers only record the time, the level, the format string pointer and a copy of the
+ *   arguments into a bounded lock-free multi-producer single-consumer queue. Formatting and writing
+ *   to the sinks happen on a background thread, which blocks while the queue is empty and is only
+ *   woken up by the first entry pushed after it went to sleep, so an idle logger causes no
+ *   periodic wake-ups. If the queue is full, the entry is dropped and counted instead of blocking
+ *   the producer.
+ *
+ * @note The format string must outlive the formatting, which holds for string literals. String
+ *   arguments, either char pointers or std::string, are copied into the entry and truncated to 127
+ *   characters. Other arguments must be trivially copyable.
+ */
+class AsyncLogger
+{
+public:
+  /// @brief Number of entries the queue can hold, a power of two
+  static constexpr size_t CAPACITY{1024};
+
+  /// @brief Maximum size in bytes of the copied arguments of an entry
+  static constexpr size_t MAX_ARGS_SIZE{320};
+
+  /// @brief Construct the asynchronous logger writing to stdout and start the background thread
+  AsyncLogger()
+  {
+    sinks_.push_back(std::make_shared<StreamSink>());
+    for (size_t i = 0; i < CAPACITY; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    activated_ = true;
+    thread_ = std::thread(&AsyncLogger::run, this);
+  }
+
+  /// @brief Drain the queue, stop the background thread, and destroy the asynchronous logger
+  ~AsyncLogger()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_wake_);
+      activated_ = false;
+    }
+    cv_wake_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  AsyncLogger(const AsyncLogger &) = delete;
+  AsyncLogger & operator=(const AsyncLogger &) = delete;
+
+  /**
+   * @brief Enqueue a message
+   *
+   * @param level The level with which to log the message
+   * @param fmt The printf-style format string
+   * @param args The arguments of the format string
+   */
+  template<typename ... Args>
+  void push(Level level, const char * fmt, Args... args)
+  {
+    using Tuple = std::tuple<detail::Stored<Args>...>;
+    static_assert(
+      sizeof(Tuple) <= MAX_ARGS_SIZE,
+      "Too many arguments for asynchronous logging");
+    static_assert(
+      (std::is_trivially_copyable_v<detail::Stored<Args>> && ...),
+      "Arguments of asynchronous logging must be trivially copyable");
+
+    size_t position = tail_.load(std::memory_order_relaxed);
+    Cell * cell;
+    while (true) {
+      cell = &cells_[position & (CAPACITY - 1)];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence) -
+        static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->time = std::chrono::system_clock::now();
+    cell->level = level;
+    cell->fmt = fmt;
+    cell->format = &AsyncLogger::format<Args...>;
+    new (cell->args) Tuple(detail::to_stored(args)...);
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    // Pairs with the fence in run(), so that either the background thread sees this entry before
+    // sleeping or this producer sees it sleeping and wakes it up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_wake_);
+        sleeping_.store(false, std::memory_order_relaxed);
+      }
+      cv_wake_.notify_one();
+    }
+  }
+
+  /**
+   * @brief Replace the sinks
+   *
+   * @param sinks The new sinks
+   */
+  void set_sinks(std::vector<std::shared_ptr<Sink>> sinks)
+  {
+    std::lock_guard<std::mutex> lock(mutex_sinks_);
+    sinks_ = std::move(sinks);
+  }
+
+  /**
+   * @brief Add a sink
+   *
+   * @param sink The sink to add
+   */
+  void add_sink(std::shared_ptr<Sink> sink)
+  {
+    std::lock_guard<std::mutex> lock(mutex_sinks_);
+    sinks_.push_back(std::move(sink));
+  }
+
+  /**
+   * @brief Get the number of entries dropped because the queue was full
+   *
+   * @return Number of dropped entries
+   */
+  uint64_t get_dropped() const
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Maximum size of a formatted message
+  static constexpr size_t MAX_MESSAGE_SIZE{1024};
+
+  // Function formatting the copied arguments with the format string
+  using FormatFunction = int (*)(char *, size_t, const char *, const void *);
+
+  // Queue cell, aligned to a cache line to avoid false sharing between producers
+  struct alignas(64) Cell
+  {
+    std::atomic<size_t> sequence;
+    std::chrono::system_clock::time_point time;
+    Level level;
+    const char * fmt;
+    FormatFunction format;
+    alignas(std::max_align_t) unsigned char args[MAX_ARGS_SIZE];
+  };
+
+  // Queue cells
+  std::array<Cell, CAPACITY> cells_;
+
+  // Next position to enqueue, shared by the producers
+  alignas(64) std::atomic<size_t> tail_{0};
+
+  // Next position to dequeue, owned by the background thread
+  alignas(64) size_t head_{0};
+
+  // Number of dropped entries
+  std::atomic<uint64_t> dropped_{0};
+
+  // Sinks
+  std::vector<std::shared_ptr<Sink>> sinks_;
+
+  // Mutex for the sinks, only contended between the background thread and sink updates
+  std::mutex mutex_sinks_;
+
+  // Atomic flag for maintaining and stopping the background thread
+  std::atomic<bool> activated_{false};
+
+  // Whether the background thread is about to block or blocked on the empty queue
+  std::atomic<bool> sleeping_{false};
+
+  // Mutex for waking up the background thread
+  std::mutex mutex_wake_;
+
+  // Condition variable waking up the background thread
+  std::condition_variable cv_wake_;
+
+  // Background thread
+  std::thread thread_;
+
+  template<typename ... Args>
+  static int format(char * buffer, size_t size, const char * fmt, const void * args)
+  {
+    return std::apply(
+      [&](auto... unpacked) {
+        if constexpr (sizeof...(unpacked) == 0) {
+          return std::snprintf(buffer, size, "%s", fmt);
+        } else {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+          return std::snprintf(buffer, size, fmt, detail::to_argument(unpacked)...);
+#pragma GCC diagnostic pop
+        }
+      },
+      *static_cast<const std::tuple<detail::Stored<Args>...> *>(args));
+  }
+
+  // Dequeue and write all available entries, return whether any was written
+  bool drain()
+  {
+    bool written = false;
+    char buffer[MAX_MESSAGE_SIZE];
+    while (true) {
+      Cell & cell = cells_[head_ & (CAPACITY - 1)];
+      if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+        break;
+      }
+      cell.format(buffer, sizeof(buffer), cell.fmt, cell.args);
+      Entry entry{cell.level, cell.time, buffer};
+      cell.sequence.store(head_ + CAPACITY, std::memory_order_release);
+      ++head_;
+
+      std::lock_guard<std::mutex> lock(mutex_sinks_);
+      for (auto & sink : sinks_) {
+        sink->write(entry);
+      }
+      written = true;
+    }
+    if (written) {
+      std::lock_guard<std::mutex> lock(mutex_sinks_);
+      for (auto & sink : sinks_) {
+        sink->flush();
+      }
+    }
+    return written;
+  }
+
+  // Check whether the next entry is ready to be dequeued
+  bool ready() const
+  {
+    return cells_[head_ & (CAPACITY - 1)].sequence.load(std::memory_order_acquire) == head_ + 1;
+  }
+
+  // Function to be executed by the background thread
+  void run()
+  {
+    while (activated_) {
+      if (drain()) {
+        continue;
+      }
+      sleeping_.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in push()
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!ready()) {
+        std::unique_lock<std::mutex> lock(mutex_wake_);
+        cv_wake_.wait(
+          lock, [this] {return !sleeping_.load(std::memory_order_relaxed) || !activated_;});
+      }
+      sleeping_.store(false, std::memory_order_relaxed);
+    }
+    drain();
+  }
+};
+
+/**
+ * @brief Get the process-wide asynchronous logger
+ *
+ * @return The asynchronous logger, started at the first use
+ */
+inline AsyncLogger & get_async_logger()
+{
+  static AsyncLogger logger;
+  return logger;
+}
+
+/**
+ * @brief Log a message asynchronously
+ *
+ * @param level The level with which to log the message
+ * @param fmt The printf-style format string
+ * @param args The arguments of the format string
+ *
+ * @note A FATAL message is logged synchronously since it throws
+ */
+template<typename ... Args>
+void log_async(Level level, const char * fmt, Args... args)
+{
+  if (level < get_level()) {
+    return;
+  }
+  if (level >= Level::FATAL) {
+    log(level, fmt, args...);
+    return;
+  }
+  get_async_logger().push(level, fmt, args...);
+}
+
+}  // namespace logging
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_LOGGING_ASYNC_HPP_
@@ -0,0 +1,484 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_METRICS_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_METRICS_HPP_
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+namespace trossen_arm
+{
+
+/**
+ * @brief Metrics of a driver
+ *
+ * @details All fields are atomics written by a single collector thread and read by any number of
+ *   scrapers, so reading the metrics never blocks the control loop or the collector.
+ */
+struct Metrics
+{
+  /**
+   * @brief Construct the metrics
+   *
+   * @param num_joints Number of joints
+   */
+  explicit Metrics(uint8_t num_joints)
+  : effort_saturations(num_joints)
+  {
+  }
+
+  /// @brief Number of joint output samples acquired
+  std::atomic<uint64_t> samples{0};
+
+  /// @brief Number of samples identical to the previous one
+  /// @details Both an arm holding still and a driver returning the joint outputs of an earlier
+  ///   communication cycle yield unchanged samples, so this is not a measure of staleness
+  std::atomic<uint64_t> unchanged_samples{0};
+
+  /// @brief Number of transitions from the healthy state to the error state
+  std::atomic<uint64_t> error_transitions{0};
+
+  /// @brief Whether the driver is currently in the error state
+  std::atomic<bool> error{false};
+
+  /// @brief Rate in Hz at which samples were acquired over the last rate window
+  std::atomic<double> sample_rate{0.0};
+
+  /// @brief Time in s taken by the last sample acquisition
+  std::atomic<double> acquisition_latency{0.0};
+
+  /// @brief Maximum time in s taken by a sample acquisition
+  std::atomic<double> max_acquisition_latency{0.0};
+
+  /// @brief Number of samples in which each joint's effort reached its saturation threshold
+  std::vector<std::atomic<uint64_t>> effort_saturations;
+};
+
+namespace detail
+{
+
+// Escape a label value as required by the Prometheus text exposition format
+inline std::string escape_label(const std::string & value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+// Format a sample value as required by the Prometheus text exposition format
+inline std::string format_value(double value)
+{
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (std::isinf(value)) {
+    return value > 0.0 ? "+Inf" : "-Inf";
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+  return buffer;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Render the metrics of one or more drivers in the Prometheus text exposition format
+ *
+ * @param metrics Pairs of the arm label, e.g., its IP address, and the metrics of the arm
+ * @return The rendered metrics
+ *
+ * @details The arm labels are escaped, so they may contain any characters.
+ */
+inline std::string render_metrics(
+  const std::vector<std::pair<std::string, const Metrics *>> & metrics)
+{
+  std::string text;
+  auto family = [&](const char * name, const char * type, const char * help) {
+    text += std::string("# HELP ") + name + " " + help + "\n";
+    text += std::string("# TYPE ") + name + " " + type + "\n";
+  };
+  auto sample = [&](const char * name, const std::string & arm, const std::string & value) {
+    text += name;
+    text += "{arm=\"";
+    text += detail::escape_label(arm);
+    text += "\"} ";
+    text += value;
+    text += "\n";
+  };
+  auto counter = [&](const char * name, const std::string & arm, uint64_t value) {
+    sample(name, arm, std::to_string(value));
+  };
+  auto gauge = [&](const char * name, const std::string & arm, double value) {
+    sample(name, arm, detail::format_value(value));
+  };
+  family(
+    "trossen_arm_samples_total", "counter",
+    "Number of joint output samples acquired");
+  for (const auto & [arm, m] : metrics) {
+    counter("trossen_arm_samples_total", arm, m->samples.load(std::memory_order_relaxed));
+  }
+  family(
+    "trossen_arm_unchanged_samples_total", "counter",
+    "Number of samples identical to the previous one");
+  for (const auto & [arm, m] : metrics) {
+    counter(
+      "trossen_arm_unchanged_samples_total", arm,
+      m->unchanged_samples.load(std::memory_order_relaxed));
+  }
+  family(
+    "trossen_arm_error_transitions_total", "counter",
+    "Number of transitions into the error state");
+  for (const auto & [arm, m] : metrics) {
+    counter(
+      "trossen_arm_error_transitions_total", arm,
+      m->error_transitions.load(std::memory_order_relaxed));
+  }
+  family("trossen_arm_error", "gauge", "Whether the driver is in the error state");
+  for (const auto & [arm, m] : metrics) {
+    gauge("trossen_arm_error", arm, m->error.load(std::memory_order_relaxed) ? 1.0 : 0.0);
+  }
+  family(
+    "trossen_arm_sample_rate_hertz", "gauge",
+    "Rate at which samples are acquired");
+  for (const auto & [arm, m] : metrics) {
+    gauge("trossen_arm_sample_rate_hertz", arm, m->sample_rate.load(std::memory_order_relaxed));
+  }
+  family(
+    "trossen_arm_acquisition_latency_seconds", "gauge",
+    "Time taken by the last sample acquisition");
+  for (const auto & [arm, m] : metrics) {
+    gauge(
+      "trossen_arm_acquisition_latency_seconds", arm,
+      m->acquisition_latency.load(std::memory_order_relaxed));
+  }
+  family(
+    "trossen_arm_max_acquisition_latency_seconds", "gauge",
+    "Maximum time taken by a sample acquisition");
+  for (const auto & [arm, m] : metrics) {
+    gauge(
+      "trossen_arm_max_acquisition_latency_seconds", arm,
+      m->max_acquisition_latency.load(std::memory_order_relaxed));
+  }
+  family(
+    "trossen_arm_effort_saturations_total", "counter",
+    "Number of samples in which the joint effort reached its saturation threshold");
+  for (const auto & [arm, m] : metrics) {
+    for (size_t i = 0; i < m->effort_saturations.size(); ++i) {
+      text += "trossen_arm_effort_saturations_total{arm=\"";
+      text += detail::escape_label(arm);
+      text += "\",joint=\"" + std::to_string(i) + "\"} ";
+      text += std::to_string(m->effort_saturations[i].load(std::memory_order_relaxed));
+      text += "\n";
+    }
+  }
+  return text;
+}
+
+/// @brief Effort limits of the WXAI V0 joints in Nm for arm joints and N for the gripper joint
+inline const std::vector<float> WXAI_V0_EFFORT_LIMITS{
+  27.0f, 27.0f, 27.0f, 7.0f, 7.0f, 7.0f, 400.0f
+};
+
+/// @brief Options of the metrics collector
+struct MetricsCollectorOptions
+{
+  /// @brief Window over which the sample rate is computed
+  std::chrono::milliseconds rate_window{1000};
+
+  /// @brief Effort limits in Nm for arm joints and N for the gripper joint, no saturation
+  /// counting if empty
+  std::vector<float> effort_limits{WXAI_V0_EFFORT_LIMITS};
+
+  /// @brief Fraction of the effort limit at which a joint is considered saturated
+  float saturation_ratio{0.95f};
+};
+
+/**
+ * @brief Metrics collector
+ *
+ * @details The collector subscribes to a state monitor and updates the metrics from its samples.
+ *   Every successful acquisition counts as a sample. The driver's public getters are the only
+ *   data source, so communication-level quantities like packet loss and retransmissions are not
+ *   observable here.
+ */
+class MetricsCollector
+{
+public:
+  /**
+   * @brief Construct the metrics collector and subscribe to the state monitor
+   *
+   * @param monitor A state monitor acquiring the efforts, which must outlive the collector
+   * @param options Options of the metrics collector
+   */
+  explicit MetricsCollector(StateMonitor & monitor, MetricsCollectorOptions options = {})
+  : monitor_(monitor),
+    options_(std::move(options)),
+    metrics_(monitor.get_driver().get_num_joints())
+  {
+    if (!options_.effort_limits.empty() &&
+      options_.effort_limits.size() != metrics_.effort_saturations.size())
+    {
+      TALOG_FATAL(
+        "Invalid effort limits size: expected %d, got %d",
+        static_cast<int>(metrics_.effort_saturations.size()),
+        static_cast<int>(options_.effort_limits.size()));
+    }
+    subscription_ = monitor_.subscribe(
+      [this](const JointStates & states) {update(states);},
+      [this](std::exception_ptr) {
+        if (!metrics_.error.exchange(true, std::memory_order_relaxed)) {
+          metrics_.error_transitions.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+  }
+
+  /// @brief Unsubscribe from the state monitor and destroy the metrics collector
+  ~MetricsCollector()
+  {
+    monitor_.unsubscribe(subscription_);
+  }
+
+  MetricsCollector(const MetricsCollector &) = delete;
+  MetricsCollector & operator=(const MetricsCollector &) = delete;
+
+  /**
+   * @brief Get the metrics
+   *
+   * @return The metrics, valid for the lifetime of the collector
+   */
+  const Metrics & get_metrics() const
+  {
+    return metrics_;
+  }
+
+private:
+  // State monitor providing the samples
+  StateMonitor & monitor_;
+
+  // Options
+  MetricsCollectorOptions options_;
+
+  // Metrics
+  Metrics metrics_;
+
+  // Identifier of the subscription to the state monitor
+  size_t subscription_{0};
+
+  // Start of the current rate window
+  std::chrono::steady_clock::time_point window_start_{};
+
+  // Sequence number at the start of the current rate window
+  uint64_t window_sequence_{0};
+
+  // Update the metrics from a sample, called on the monitor thread
+  void update(const JointStates & states)
+  {
+    metrics_.error.store(false, std::memory_order_relaxed);
+    metrics_.samples.store(states.sequence, std::memory_order_relaxed);
+    if (!states.changed) {
+      metrics_.unchanged_samples.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    double latency =
+      std::chrono::duration<double>(states.acquisition_end - states.acquisition_start).count();
+    metrics_.acquisition_latency.store(latency, std::memory_order_relaxed);
+    if (latency > metrics_.max_acquisition_latency.load(std::memory_order_relaxed)) {
+      metrics_.max_acquisition_latency.store(latency, std::memory_order_relaxed);
+    }
+
+    if (states.efforts.size() == options_.effort_limits.size()) {
+      for (size_t i = 0; i < options_.effort_limits.size(); ++i) {
+        if (std::fabs(states.efforts[i]) >= options_.saturation_ratio * options_.effort_limits[i]) {
+          metrics_.effort_saturations[i].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    if (window_sequence_ == 0) {
+      window_start_ = states.acquisition_end;
+      window_sequence_ = states.sequence;
+    } else if (states.acquisition_end - window_start_ >= options_.rate_window) {
+      metrics_.sample_rate.store(
+        (states.sequence - window_sequence_) /
+        std::chrono::duration<double>(states.acquisition_end - window_start_).count(),
+        std::memory_order_relaxed);
+      window_start_ = states.acquisition_end;
+      window_sequence_ = states.sequence;
+    }
+  }
+};
+
+/**
+ * @brief Metrics server
+ *
+ * @details The server answers every HTTP request on the given address and port with the
+ *   metrics of the registered arms in the Prometheus text exposition format. Scraping only reads
+ *   atomics and never touches the drivers.
+ */
+class MetricsServer
+{
+public:
+  /**
+   * @brief Construct the metrics server and start serving
+   *
+   * @param metrics Pairs of the arm label, e.g., its IP address, and the metrics of the arm, which
+   *   must outlive the server
+   * @param port TCP port to listen on
+   * @param address Optional: IP address to bind to, default 127.0.0.1
+   */
+  MetricsServer(
+    std::vector<std::pair<std::string, const Metrics *>> metrics,
+    uint16_t port,
+    const std::string & address = "127.0.0.1")
+  : metrics_(std::move(metrics))
+  {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+      TALOG_FATAL("Invalid metrics server address, got %s", address.c_str());
+    }
+    sockfd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (sockfd_ < 0) {
+      TALOG_FATAL("Failed to create the metrics server socket");
+    }
+    int reuse = 1;
+    setsockopt(sockfd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(sockfd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(sockfd_, 8) < 0)
+    {
+      close(sockfd_);
+      TALOG_FATAL("Failed to listen on %s:%d for metrics", address.c_str(), port);
+    }
+    activated_ = true;
+    thread_ = std::thread(&MetricsServer::run, this);
+  }
+
+  /// @brief Stop serving and destroy the metrics server
+  ~MetricsServer()
+  {
+    activated_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    close(sockfd_);
+  }
+
+  MetricsServer(const MetricsServer &) = delete;
+  MetricsServer & operator=(const MetricsServer &) = delete;
+
+private:
+  // Interval in milliseconds at which the serving thread checks whether to stop
+  static constexpr int POLL_INTERVAL_MS{100};
+
+  // Metrics to serve
+  std::vector<std::pair<std::string, const Metrics *>> metrics_;
+
+  // Listening socket file descriptor
+  int sockfd_{-1};
+
+  // Atomic flag for maintaining and stopping the serving thread
+  std::atomic<bool> activated_{false};
+
+  // Serving thread
+  std::thread thread_;
+
+  // Function to be executed by the serving thread
+  void run()
+  {
+    while (activated_) {
+      pollfd pfd{sockfd_, POLLIN, 0};
+      if (poll(&pfd, 1, POLL_INTERVAL_MS) <= 0) {
+        continue;
+      }
+      int connfd = accept(sockfd_, nullptr, nullptr);
+      if (connfd < 0) {
+        continue;
+      }
+      // The request itself is irrelevant, drain what has arrived and answer with the metrics
+      char request[1024];
+      pollfd cfd{connfd, POLLIN, 0};
+      if (poll(&cfd, 1, POLL_INTERVAL_MS) > 0) {
+        recv(connfd, request, sizeof(request), 0);
+      }
+      std::string body = render_metrics(metrics_);
+      std::string response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+      size_t sent = 0;
+      while (sent < response.size()) {
+        ssize_t n = ::send(connfd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+          break;
+        }
+        sent += n;
+      }
+      close(connfd);
+    }
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_METRICS_HPP_
@@ -0,0 +1,456 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_MONITOR_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_MONITOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Snapshot of the joint states
+struct JointStates
+{
+  /// @brief Sequence number, incremented for every successful acquisition
+  uint64_t sequence{0};
+
+  /// @brief Whether any acquired field differs from the previous sample
+  /// @details An arm holding still yields identical samples as well, so an unchanged sample does
+  ///   not mean that the driver missed a communication cycle
+  bool changed{false};
+
+  /// @brief Host time right before the acquisition started
+  std::chrono::steady_clock::time_point acquisition_start;
+
+  /// @brief Host time right after the acquisition ended
+  std::chrono::steady_clock::time_point acquisition_end;
+
+  /// @brief Host time right after the positions getter returned
+  /// @details The positions getter returns the joint outputs of the latest communication cycle,
+  ///   which completed at some point while the getter waited for its turn, so the positions were
+  ///   received by the driver no later than this time
+  std::chrono::steady_clock::time_point time;
+
+  /// @brief Upper bound in s on how long before time the positions were received, the duration of
+  /// the positions getter call
+  double time_uncertainty{0.0};
+
+  /// @brief Positions in rad for arm joints and m for the gripper joint
+  std::vector<float> positions;
+
+  /// @brief Velocities in rad/s for arm joints and m/s for the gripper joint
+  std::vector<float> velocities;
+
+  /// @brief Efforts in Nm for arm joints and N for the gripper joint
+  std::vector<float> efforts;
+
+  /// @brief External efforts in Nm for arm joints and N for the gripper joint
+  std::vector<float> external_efforts;
+};
+
+/// @brief Options of the state monitor
+struct StateMonitorOptions
+{
+  /// @brief Minimum period between two acquisitions
+  std::chrono::microseconds period{1000};
+
+  /// @brief Period between two acquisition attempts while the driver is in the error state
+  std::chrono::milliseconds error_period{100};
+
+  /// @brief Whether to acquire the velocities
+  bool velocities{true};
+
+  /// @brief Whether to acquire the efforts
+  bool efforts{true};
+
+  /// @brief Whether to acquire the external efforts
+  bool external_efforts{true};
+};
+
+/**
+ * @brief State monitor
+ *
+ * @details The monitor acquires the joint states of a configured driver from a single thread and
+ *   shares them with any number of consumers, which either register a callback or block until the
+ *   next sample arrives. Consumers therefore neither busy-poll nor compete with each other for the
+ *   driver.
+ *
+ *   Every successful acquisition produces a sample, flagged as changed if any acquired field
+ *   differs from the previous sample. Every sample is stamped with the host time at which the
+ *   positions getter returned, which bounds the receive time tighter than stamping after all
+ *   getters return. Each acquired field takes its own communication cycle, so velocities and
+ *   efforts are up to a few cycles newer than the positions.
+ *
+ *   Acquisition is paused while the driver reports zero joints, i.e., before it is configured, and
+ *   between pause() and resume(), e.g., while another thread configures the driver again.
+ *
+ *   If the driver throws, the exception is stored and rethrown to the waiting consumers, passed to
+ *   the error callbacks, and the monitor keeps retrying at the error period until the driver
+ *   recovers, e.g., after being configured again.
+ *
+ *   Callbacks are invoked without holding the lock of the subscriptions, so they may subscribe
+ *   and unsubscribe. Once unsubscribe() returns on another thread, the callbacks of the
+ *   subscription are no longer invoked.
+ *
+ * @note Every acquired field takes one communication cycle of the driver, so disable the fields
+ *   that are not needed
+ */
+class StateMonitor
+{
+public:
+  /// @brief Callback invoked on the monitor thread for every sample
+  using Callback = std::function<void (const JointStates &)>;
+
+  /// @brief Callback invoked on the monitor thread when the driver throws
+  using ErrorCallback = std::function<void (std::exception_ptr)>;
+
+  /**
+   * @brief Construct the state monitor and start acquiring
+   *
+   * @param driver A configured driver, which must outlive the monitor
+   * @param options Options of the state monitor
+   */
+  explicit StateMonitor(TrossenArmDriver & driver, StateMonitorOptions options = {})
+  : driver_(driver),
+    options_(std::move(options))
+  {
+    activated_ = true;
+    thread_ = std::thread(&StateMonitor::run, this);
+  }
+
+  /// @brief Stop acquiring and destroy the state monitor
+  ~StateMonitor()
+  {
+    activated_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  StateMonitor(const StateMonitor &) = delete;
+  StateMonitor & operator=(const StateMonitor &) = delete;
+
+  /**
+   * @brief Get the driver being monitored
+   *
+   * @return The driver
+   */
+  TrossenArmDriver & get_driver()
+  {
+    return driver_;
+  }
+
+  /**
+   * @brief Register callbacks
+   *
+   * @param callback Callback invoked for every sample
+   * @param error_callback Optional: callback invoked when the driver throws
+   * @return Identifier of the subscription
+   *
+   * @warning The callbacks run on the monitor thread and delay the next acquisition, so they
+   *   should return quickly
+   */
+  size_t subscribe(Callback callback, ErrorCallback error_callback = nullptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_subscribers_);
+    subscribers_.emplace(next_subscription_, std::make_pair(
+        std::move(callback), std::move(error_callback)));
+    subscribers_changed_ = true;
+    return next_subscription_++;
+  }
+
+  /**
+   * @brief Unregister callbacks
+   *
+   * @param subscription Identifier of the subscription returned by subscribe()
+   */
+  void unsubscribe(size_t subscription)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_subscribers_);
+      subscribers_.erase(subscription);
+      subscribers_changed_ = true;
+    }
+    // Wait for a dispatch in progress, which may still invoke the removed callbacks, unless called
+    // from one of them
+    if (std::this_thread::get_id() != thread_.get_id()) {
+      std::lock_guard<std::mutex> lock(mutex_dispatch_);
+    }
+  }
+
+  /**
+   * @brief Pause acquiring
+   *
+   * @details When called from another thread than the monitor thread, returns after any
+   *   acquisition in progress, including the callbacks, has completed, so the caller can then
+   *   clean up or configure the driver without racing the monitor. Calls nest, acquisition
+   *   resumes once every pause() is matched by a resume().
+   */
+  void pause()
+  {
+    ++pauses_;
+    if (std::this_thread::get_id() != thread_.get_id()) {
+      std::lock_guard<std::mutex> lock(mutex_driver_);
+    }
+  }
+
+  /// @brief Resume acquiring after pause()
+  void resume()
+  {
+    --pauses_;
+  }
+
+  /**
+   * @brief Get the latest joint states
+   *
+   * @return The latest joint states, with sequence 0 if none has been acquired yet
+   */
+  JointStates get_states()
+  {
+    std::lock_guard<std::mutex> lock(mutex_states_);
+    rethrow_if_failed();
+    return states_;
+  }
+
+  /**
+   * @brief Block until a sample newer than the given sequence number arrives
+   *
+   * @param states The joint states to fill, with its sequence number as the last one seen
+   * @param timeout Maximum time to wait
+   * @return true New joint states were written to states
+   * @return false The timeout elapsed
+   */
+  template<typename Rep, typename Period>
+  bool wait_for_states(JointStates & states, std::chrono::duration<Rep, Period> timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_states_);
+    uint64_t last_sequence = states.sequence;
+    bool arrived = cv_states_.wait_for(
+      lock, timeout, [&] {return states_.sequence > last_sequence || exception_ptr_;});
+    rethrow_if_failed();
+    if (arrived) {
+      states = states_;
+    }
+    return arrived;
+  }
+
+private:
+  // Driver being monitored
+  TrossenArmDriver & driver_;
+
+  // Options
+  StateMonitorOptions options_;
+
+  // Latest joint states
+  JointStates states_;
+
+  // Exception thrown by the driver at the latest acquisition if any
+  std::exception_ptr exception_ptr_;
+
+  // Mutex for the latest joint states and the exception
+  std::mutex mutex_states_;
+
+  // Condition variable notified at every sample and every failure
+  std::condition_variable cv_states_;
+
+  // Subscribers
+  std::map<size_t, std::pair<Callback, ErrorCallback>> subscribers_;
+
+  // Identifier of the next subscription
+  size_t next_subscription_{0};
+
+  // Whether the subscribers changed since the last dispatch
+  bool subscribers_changed_{false};
+
+  // Mutex for the subscribers
+  std::mutex mutex_subscribers_;
+
+  // Copy of the subscribers the monitor thread dispatches to
+  std::vector<std::pair<Callback, ErrorCallback>> dispatched_;
+
+  // Mutex held by the monitor thread while dispatching
+  std::mutex mutex_dispatch_;
+
+  // Mutex held by the monitor thread while acquiring and dispatching a sample
+  std::mutex mutex_driver_;
+
+  // Number of pause() calls not yet matched by a resume()
+  std::atomic<int> pauses_{0};
+
+  // Atomic flag for maintaining and stopping the monitor thread
+  std::atomic<bool> activated_{false};
+
+  // Monitor thread
+  std::thread thread_;
+
+  // Rethrow the stored exception, the caller must hold mutex_states_
+  void rethrow_if_failed()
+  {
+    if (exception_ptr_) {
+      std::rethrow_exception(exception_ptr_);
+    }
+  }
+
+  // Function to be executed by the monitor thread
+  void run()
+  {
+    JointStates states;
+    auto next = std::chrono::steady_clock::now();
+    while (activated_) {
+      next += options_.period;
+      std::this_thread::sleep_until(next);
+
+      // Hold the driver for the whole iteration so that pause() can wait for it
+      std::lock_guard<std::mutex> driver_lock(mutex_driver_);
+      // Wait for the driver to be configured or resumed instead of flooding the log with warnings
+      if (pauses_ > 0 || driver_.get_num_joints() == 0) {
+        next = std::chrono::steady_clock::now() + options_.error_period;
+        continue;
+      }
+
+      JointStates sample;
+      sample.acquisition_start = std::chrono::steady_clock::now();
+      try {
+        sample.positions = driver_.get_positions();
+        auto positions_end = std::chrono::steady_clock::now();
+        sample.time = positions_end;
+        sample.time_uncertainty =
+          std::chrono::duration<double>(positions_end - sample.acquisition_start).count();
+        if (options_.velocities) {
+          sample.velocities = driver_.get_velocities();
+        }
+        if (options_.efforts) {
+          sample.efforts = driver_.get_efforts();
+        }
+        if (options_.external_efforts) {
+          sample.external_efforts = driver_.get_external_efforts();
+        }
+      } catch (...) {
+        fail(std::current_exception());
+        next = std::chrono::steady_clock::now() + options_.error_period;
+        continue;
+      }
+      sample.acquisition_end = std::chrono::steady_clock::now();
+
+      sample.changed =
+        sample.positions != states.positions ||
+        sample.velocities != states.velocities ||
+        sample.efforts != states.efforts ||
+        sample.external_efforts != states.external_efforts;
+      sample.sequence = states.sequence + 1;
+      states = std::move(sample);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_states_);
+        exception_ptr_ = nullptr;
+        states_ = states;
+      }
+      cv_states_.notify_all();
+      std::exception_ptr exception_ptr;
+      {
+        std::lock_guard<std::mutex> lock(mutex_dispatch_);
+        refresh_dispatched();
+        for (auto & callbacks : dispatched_) {
+          if (!callbacks.first) {
+            continue;
+          }
+          try {
+            callbacks.first(states);
+          } catch (...) {
+            exception_ptr = std::current_exception();
+          }
+        }
+      }
+      // Callbacks commanding the driver rethrow its failures
+      if (exception_ptr) {
+        fail(exception_ptr);
+      }
+
+      // Do not try to catch up after a long acquisition
+      if (next < states.acquisition_end) {
+        next = states.acquisition_end;
+      }
+    }
+  }
+
+  // Store and propagate an exception thrown by the driver
+  void fail(std::exception_ptr exception_ptr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_states_);
+      exception_ptr_ = exception_ptr;
+    }
+    cv_states_.notify_all();
+    std::lock_guard<std::mutex> lock(mutex_dispatch_);
+    refresh_dispatched();
+    for (auto & callbacks : dispatched_) {
+      if (!callbacks.second) {
+        continue;
+      }
+      try {
+        callbacks.second(exception_ptr);
+      } catch (const std::exception & e) {
+        TALOG_ERROR("State monitor error callback threw: %s", e.what());
+      } catch (...) {
+        TALOG_ERROR("State monitor error callback threw an unknown exception");
+      }
+    }
+  }
+
+  // Copy the subscribers if they changed, the caller must hold mutex_dispatch_
+  void refresh_dispatched()
+  {
+    std::lock_guard<std::mutex> lock(mutex_subscribers_);
+    if (!subscribers_changed_) {
+      return;
+    }
+    dispatched_.clear();
+    for (auto & [subscription, callbacks] : subscribers_) {
+      dispatched_.push_back(callbacks);
+    }
+    subscribers_changed_ = false;
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_MONITOR_HPP_
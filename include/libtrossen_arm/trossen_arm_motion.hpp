@@ -0,0 +1,138 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_MOTION_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_MOTION_HPP_
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Convergence criterion of a motion
+struct ConvergenceCriterion
+{
+  /// @brief Maximum position error in rad or m of every joint
+  float position_tolerance{0.01f};
+
+  /// @brief Maximum velocity in rad/s or m/s of every joint, not checked if the state monitor
+  /// does not acquire velocities
+  float velocity_tolerance{0.05f};
+
+  /// @brief Time during which every sample must meet the tolerances, measured between the sample
+  /// times, 0 to finish at the first sample meeting them
+  std::chrono::microseconds settle_time{10000};
+
+  /// @brief Index of the first joint of the goal positions
+  uint8_t first_joint{0};
+};
+
+/**
+ * @brief Block until the measured joint positions converge to goal positions
+ *
+ * @param monitor A state monitor of the driver executing the motion
+ * @param goal_positions Goal positions in rad or m of the joints from criterion.first_joint on
+ * @param timeout Maximum time to wait
+ * @param criterion Optional: convergence criterion
+ * @return true The joints converged
+ * @return false The timeout elapsed
+ *
+ * @details Use with non-blocking setters, e.g., set_all_positions(goal, goal_time, false).
+ *   Instead of sleeping for the goal time, the caller is woken by the state monitor at every
+ *   sample and returns once the samples have met the tolerances for the settle time, so
+ *   sequential motions chain without coarse sleeps and only end once the arm actually arrived.
+ *   Only samples acquired after the call are considered. The settle time is measured in wall-clock
+ *   time, so the criterion does not depend on the period of the monitor.
+ */
+template<typename Rep, typename Period>
+bool wait_until_done(
+  StateMonitor & monitor,
+  const std::vector<float> & goal_positions,
+  std::chrono::duration<Rep, Period> timeout,
+  const ConvergenceCriterion & criterion = {})
+{
+  size_t num_joints = monitor.get_driver().get_num_joints();
+  if (goal_positions.empty() || criterion.first_joint + goal_positions.size() > num_joints) {
+    TALOG_FATAL(
+      "Invalid goal positions: expected at most %d joints from joint %d, got %d",
+      static_cast<int>(num_joints) - criterion.first_joint, criterion.first_joint,
+      static_cast<int>(goal_positions.size()));
+  }
+
+  auto converged = [&](const JointStates & states) {
+      for (size_t i = 0; i < goal_positions.size(); ++i) {
+        size_t joint = criterion.first_joint + i;
+        if (joint >= states.positions.size() ||
+          !(std::fabs(states.positions[joint] - goal_positions[i]) <=
+          criterion.position_tolerance))
+        {
+          return false;
+        }
+        if (joint < states.velocities.size() &&
+          !(std::fabs(states.velocities[joint]) <= criterion.velocity_tolerance))
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  JointStates states;
+  states.sequence = monitor.get_states().sequence;
+  bool settling = false;
+  std::chrono::steady_clock::time_point settle_start;
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline || !monitor.wait_for_states(states, deadline - now)) {
+      return false;
+    }
+    if (!converged(states)) {
+      settling = false;
+      continue;
+    }
+    if (!settling) {
+      settling = true;
+      settle_start = states.time;
+    }
+    if (states.time - settle_start >= criterion.settle_time) {
+      return true;
+    }
+  }
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_MOTION_HPP_
@@ -0,0 +1,126 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_REALTIME_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_REALTIME_HPP_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Real-time scheduling options of a thread
+struct RealtimeOptions
+{
+  /// @brief SCHED_FIFO priority within [1, 99], 0 to keep the current policy
+  int priority{0};
+
+  /// @brief CPUs the thread may run on, each within [0, CPU_SETSIZE - 1], unchanged if empty
+  std::vector<int> cpus{};
+};
+
+/**
+ * @brief Apply real-time scheduling options to the calling thread
+ *
+ * @param options The real-time scheduling options
+ *
+ * @note SCHED_FIFO requires CAP_SYS_NICE or a suitable RLIMIT_RTPRIO
+ */
+inline void set_thread_realtime(const RealtimeOptions & options)
+{
+  if (!options.cpus.empty()) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : options.cpus) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        TALOG_FATAL("Invalid CPU: expected within [0, %d], got %d", CPU_SETSIZE - 1, cpu);
+      }
+      CPU_SET(cpu, &cpuset);
+    }
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (result != 0) {
+      TALOG_FATAL("Failed to set the CPU affinity: %s", std::strerror(result));
+    }
+  }
+  if (options.priority != 0) {
+    sched_param param{};
+    param.sched_priority = options.priority;
+    int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (result != 0) {
+      TALOG_FATAL(
+        "Failed to set SCHED_FIFO priority %d: %s", options.priority, std::strerror(result));
+    }
+  }
+}
+
+/**
+ * @brief Configure a driver so that its daemon thread runs with real-time scheduling options
+ *
+ * @param driver The driver to configure
+ * @param configuration The configuration
+ * @param options The real-time scheduling options of the daemon thread
+ *
+ * @details The daemon thread is created by configure() and inherits the scheduling policy,
+ *   priority, and CPU affinity of the thread calling it. The driver is therefore configured from a
+ *   helper thread with the given options, which leaves the calling thread unchanged. A daemon on a
+ *   dedicated core with a real-time priority wakes up from its blocking receive with much less
+ *   scheduler slack.
+ */
+inline void configure_realtime(
+  TrossenArmDriver & driver,
+  const DriverConfiguration & configuration,
+  const RealtimeOptions & options)
+{
+  std::exception_ptr exception_ptr;
+  std::thread helper([&] {
+      try {
+        set_thread_realtime(options);
+        apply_driver_configuration(driver, configuration);
+      } catch (...) {
+        exception_ptr = std::current_exception();
+      }
+    });
+  helper.join();
+  if (exception_ptr) {
+    std::rethrow_exception(exception_ptr);
+  }
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_REALTIME_HPP_
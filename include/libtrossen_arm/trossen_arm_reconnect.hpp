@@ -0,0 +1,376 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_RECONNECT_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_RECONNECT_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_group.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+#include "libtrossen_arm/trossen_arm_realtime.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Options of the reconnect supervisor
+struct ReconnectOptions
+{
+  /// @brief Delay before the first reconnection attempt
+  std::chrono::milliseconds initial_backoff{10};
+
+  /// @brief Maximum delay between two reconnection attempts, the delay doubles after every failure
+  std::chrono::milliseconds max_backoff{1000};
+
+  /// @brief Maximum number of consecutive reconnection attempts, unlimited if 0
+  uint32_t max_attempts{0};
+
+  /// @brief Period at which the modes are cached while connected
+  std::chrono::milliseconds mode_cache_period{500};
+
+  /// @brief Whether to clear the error state of the robot when reconnecting
+  /// @details Only enable this if resuming is safe after the robot faulted because of the lost
+  ///   connection, e.g., with a watchdog stopping the motion on the controller side
+  bool clear_error{false};
+
+  /// @brief Real-time scheduling options of the daemon thread if the driver was configured with
+  ///   configure_realtime(), reapplied at every reconnection
+  std::optional<RealtimeOptions> realtime{};
+
+  /// @brief Called on the supervisor thread before the driver is cleaned up, which must return
+  ///   only once no other thread than the monitor's calls the driver, none by default
+  std::function<void()> pause{};
+
+  /// @brief Called on the supervisor thread after every reconnection attempt, successful or not,
+  ///   to undo pause, none by default
+  std::function<void()> resume{};
+};
+
+namespace detail
+{
+
+// Messages of the prebuilt libtrossen_arm.a 1.7.1 reporting a lost connection, the first thrown by
+// the driver when the controller does not answer and the second prefixing every socket error of
+// the UDP client, to be updated whenever the library changes its wording
+constexpr const char * NO_RESPONSE_MESSAGE{"Failed to receive a response"};
+constexpr const char * UDP_CLIENT_MESSAGE_PREFIX{"[UDP Client]"};
+
+// Get the message of an exception thrown by the driver
+inline std::string exception_message(std::exception_ptr exception_ptr)
+{
+  try {
+    std::rethrow_exception(exception_ptr);
+  } catch (const std::exception & e) {
+    return e.what();
+  } catch (...) {
+    return "unknown exception";
+  }
+}
+
+// Whether the message of an exception thrown by the driver reports a lost connection rather than,
+// e.g., a robot fault or an invalid argument
+inline bool is_communication_error(const std::string & message)
+{
+  return message.find(NO_RESPONSE_MESSAGE) != std::string::npos ||
+         message.find(UDP_CLIENT_MESSAGE_PREFIX) != std::string::npos;
+}
+
+}  // namespace detail
+
+/// @brief Metrics of the reconnect supervisor
+struct ReconnectMetrics
+{
+  /// @brief Whether the driver is currently connected
+  /// @note It only turns false once the monitor has detected the failure, so driver calls of other
+  ///   threads may fail before
+  bool connected{true};
+
+  /// @brief Number of successful reconnections
+  uint64_t reconnections{0};
+
+  /// @brief Number of failed reconnection attempts
+  uint64_t failed_attempts{0};
+
+  /// @brief Time in s from the failure detection to the last successful reconnection
+  double last_reconnection_latency{0.0};
+
+  /// @brief Maximum time in s from a failure detection to the successful reconnection
+  double max_reconnection_latency{0.0};
+};
+
+/**
+ * @brief Reconnect supervisor
+ *
+ * @details The supervisor watches a state monitor for communication errors, e.g., after an
+ *   Ethernet link blip. On such an error, it pauses the monitor, cleans up the driver and
+ *   configures it again in the background with the cached configuration, retrying with an
+ *   exponential backoff, restores the cached modes, and resumes the monitor, so that streaming
+ *   commands resumes without user intervention. The configuration is cached once and the modes
+ *   periodically while connected.
+ *
+ *   Other errors, e.g., a robot fault like an overheated joint, are logged and left to the user,
+ *   since reconnecting would hide them.
+ *
+ * @note Motions in progress are not resumed, joints in the position mode hold the positions
+ *   measured after reconnecting
+ *
+ * @warning Driver calls from other threads than the monitor's race with the reconnection.
+ *   Components running on the monitor thread, i.e., CommandArbiter, JointMailbox,
+ *   StateBusPublisher, and MetricsCollector, are paused with the monitor. Other threads calling the
+ *   driver must be suspended through the pause and resume hooks of the options. CommandStreamer,
+ *   TeleoperationEngine, and EpisodeRecorder call the driver from their own threads and stop at
+ *   their first driver error, so they must not be combined with the supervisor.
+ */
+class ReconnectSupervisor
+{
+public:
+  /**
+   * @brief Construct the reconnect supervisor and start supervising
+   *
+   * @param monitor A state monitor of the configured driver, which must outlive the supervisor
+   * @param configuration The configuration the driver was configured with
+   * @param options Options of the reconnect supervisor
+   */
+  ReconnectSupervisor(
+    StateMonitor & monitor,
+    DriverConfiguration configuration,
+    ReconnectOptions options = {})
+  : monitor_(monitor),
+    configuration_(std::move(configuration)),
+    options_(std::move(options)),
+    modes_(monitor.get_driver().get_modes())
+  {
+    configuration_.clear_error = options_.clear_error;
+    subscription_ = monitor_.subscribe(
+      [this](const JointStates &) {faulted_.store(false, std::memory_order_relaxed);},
+      [this](std::exception_ptr exception_ptr) {
+        std::string message = detail::exception_message(exception_ptr);
+        if (!detail::is_communication_error(message)) {
+          if (!faulted_.exchange(true, std::memory_order_relaxed)) {
+            TALOG_ERROR(
+              "Not reconnecting to %s after an error other than a lost connection: %s",
+              configuration_.serv_ip.c_str(), message.c_str());
+          }
+          return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!failed_) {
+          failed_ = true;
+          failure_time_ = std::chrono::steady_clock::now();
+          cv_.notify_all();
+        }
+      });
+    activated_ = true;
+    thread_ = std::thread(&ReconnectSupervisor::run, this);
+  }
+
+  /// @brief Stop supervising and destroy the reconnect supervisor
+  ~ReconnectSupervisor()
+  {
+    monitor_.unsubscribe(subscription_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      activated_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  ReconnectSupervisor(const ReconnectSupervisor &) = delete;
+  ReconnectSupervisor & operator=(const ReconnectSupervisor &) = delete;
+
+  /**
+   * @brief Get the metrics
+   *
+   * @return The metrics
+   */
+  ReconnectMetrics get_metrics()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_;
+  }
+
+private:
+  // State monitor detecting failures
+  StateMonitor & monitor_;
+
+  // Cached configuration
+  DriverConfiguration configuration_;
+
+  // Options
+  ReconnectOptions options_;
+
+  // Cached modes
+  std::vector<Mode> modes_;
+
+  // Whether a communication error has been detected and not yet recovered from
+  bool failed_{false};
+
+  // Whether another error has been reported since the last sample
+  std::atomic<bool> faulted_{false};
+
+  // Time at which the failure was detected
+  std::chrono::steady_clock::time_point failure_time_;
+
+  // Metrics
+  ReconnectMetrics metrics_;
+
+  // Mutex for the failure state and the metrics
+  std::mutex mutex_;
+
+  // Condition variable notified at failures and stopping
+  std::condition_variable cv_;
+
+  // Identifier of the subscription to the state monitor
+  size_t subscription_{0};
+
+  // Flag for maintaining and stopping the supervisor thread, guarded by mutex_
+  bool activated_{false};
+
+  // Supervisor thread
+  std::thread thread_;
+
+  // Try to reconnect once, return whether it succeeded
+  bool reconnect()
+  {
+    TrossenArmDriver & driver = monitor_.get_driver();
+    // Keep the monitor and the other users off the driver while it is reconfigured
+    monitor_.pause();
+    bool reconnected = true;
+    try {
+      if (options_.pause) {
+        options_.pause();
+      }
+      driver.cleanup();
+      if (options_.realtime) {
+        configure_realtime(driver, configuration_, *options_.realtime);
+      } else {
+        apply_driver_configuration(driver, configuration_);
+      }
+      driver.set_joint_modes(modes_);
+    } catch (const std::exception & e) {
+      TALOG_WARN("Reconnection to %s failed: %s", configuration_.serv_ip.c_str(), e.what());
+      reconnected = false;
+    }
+    if (options_.resume) {
+      try {
+        options_.resume();
+      } catch (const std::exception & e) {
+        TALOG_ERROR(
+          "Resume hook failed after reconnecting to %s: %s",
+          configuration_.serv_ip.c_str(), e.what());
+      }
+    }
+    monitor_.resume();
+    return reconnected;
+  }
+
+  // Function to be executed by the supervisor thread
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (activated_) {
+      if (!failed_) {
+        // Refresh the cached modes while connected
+        if (!cv_.wait_for(lock, options_.mode_cache_period, [this] {
+            return failed_ || !activated_;
+          }))
+        {
+          lock.unlock();
+          std::vector<Mode> modes;
+          try {
+            modes = monitor_.get_driver().get_modes();
+          } catch (const std::exception &) {
+          }
+          lock.lock();
+          if (!failed_ && modes.size() == modes_.size()) {
+            modes_ = std::move(modes);
+          }
+        }
+        continue;
+      }
+
+      metrics_.connected = false;
+      TALOG_WARN("Connection to %s lost, reconnecting", configuration_.serv_ip.c_str());
+      auto backoff = options_.initial_backoff;
+      uint32_t attempts = 0;
+      bool reconnected = false;
+      while (activated_ && !reconnected) {
+        if (options_.max_attempts != 0 && attempts >= options_.max_attempts) {
+          TALOG_ERROR(
+            "Giving up reconnecting to %s after %d attempts",
+            configuration_.serv_ip.c_str(), attempts);
+          activated_ = false;
+          break;
+        }
+        if (cv_.wait_for(lock, backoff, [this] {return !activated_;})) {
+          break;
+        }
+        ++attempts;
+        lock.unlock();
+        reconnected = reconnect();
+        lock.lock();
+        if (!reconnected) {
+          ++metrics_.failed_attempts;
+          backoff = std::min(backoff * 2, options_.max_backoff);
+        }
+      }
+      if (reconnected) {
+        double latency = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - failure_time_).count();
+        failed_ = false;
+        metrics_.connected = true;
+        ++metrics_.reconnections;
+        metrics_.last_reconnection_latency = latency;
+        metrics_.max_reconnection_latency = std::max(metrics_.max_reconnection_latency, latency);
+        TALOG_INFO(
+          "Reconnected to %s in %.3f s", configuration_.serv_ip.c_str(), latency);
+      }
+    }
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_RECONNECT_HPP_
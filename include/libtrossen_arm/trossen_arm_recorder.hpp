@@ -0,0 +1,705 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_RECORDER_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_RECORDER_HPP_
+
+#ifdef TROSSEN_ARM_RECORDER_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+namespace trossen_arm
+{
+
+namespace detail
+{
+
+// Magic number at the start of an episode file
+constexpr char EPISODE_MAGIC[8] = {'T', 'A', 'E', 'P', 'I', 'S', 'O', 'D'};
+
+// Version of the episode file layout
+constexpr uint32_t EPISODE_VERSION{1};
+
+// Types of the blocks of an episode file
+enum class EpisodeBlock : uint32_t {
+  states = 1,
+  events = 2,
+};
+
+// Compression of the blocks of an episode file
+enum class EpisodeCompression : uint32_t {
+  none = 0,
+  zlib = 1,
+};
+
+// Header of a block of an episode file, followed by the stored bytes
+struct EpisodeBlockHeader
+{
+  uint32_t type;
+  uint32_t compression;
+  uint64_t num_rows;
+  uint64_t raw_size;
+  uint64_t stored_size;
+};
+
+// Append a column to a block
+template<typename T>
+void append_column(std::vector<uint8_t> & block, const std::vector<T> & column)
+{
+  const uint8_t * bytes = reinterpret_cast<const uint8_t *>(column.data());
+  block.insert(block.end(), bytes, bytes + column.size() * sizeof(T));
+}
+
+// Read a column of a block, advancing the offset
+template<typename T>
+void read_column(
+  const std::vector<uint8_t> & block,
+  size_t & offset,
+  size_t count,
+  std::vector<T> & column)
+{
+  if (offset > block.size() || count > (block.size() - offset) / sizeof(T)) {
+    throw std::runtime_error("Truncated episode block");
+  }
+  size_t begin = column.size();
+  column.resize(begin + count);
+  std::memcpy(column.data() + begin, block.data() + offset, count * sizeof(T));
+  offset += count * sizeof(T);
+}
+
+}  // namespace detail
+
+/// @brief Options of the episode recorder
+struct EpisodeRecorderOptions
+{
+  /// @brief Period of the common sampling clock
+  std::chrono::microseconds period{2000};
+
+  /// @brief Number of rows per chunk
+  size_t chunk_rows{1000};
+
+  /// @brief zlib compression level in [1, 9], only used if TROSSEN_ARM_RECORDER_ZLIB is defined
+  int compression_level{1};
+};
+
+/// @brief Recorded columns of an arm
+struct EpisodeArmData
+{
+  /// @brief Number of joints
+  uint8_t num_joints{0};
+
+  /// @brief Sequence number of the monitor sample of every row
+  std::vector<uint64_t> sequence{};
+
+  /// @brief Time in ns of the monitor sample of every row
+  std::vector<int64_t> time{};
+
+  /// @brief Joint positions of every row in row-major order
+  std::vector<float> positions{};
+
+  /// @brief Joint velocities of every row in row-major order
+  std::vector<float> velocities{};
+
+  /// @brief Joint efforts of every row in row-major order
+  std::vector<float> efforts{};
+
+  /// @brief Joint external efforts of every row in row-major order
+  std::vector<float> external_efforts{};
+};
+
+/// @brief Recorded episode
+struct EpisodeData
+{
+  /// @brief Period of the common sampling clock in ns
+  int64_t period{0};
+
+  /// @brief Time in ns of the common clock tick of every row
+  std::vector<int64_t> time{};
+
+  /// @brief Recorded columns of every arm
+  std::vector<EpisodeArmData> arms{};
+
+  /// @brief Stream of every external event, e.g., a camera
+  std::vector<uint32_t> event_streams{};
+
+  /// @brief Index of every external event, e.g., the frame index
+  std::vector<uint64_t> event_indices{};
+
+  /// @brief Time in ns of every external event
+  std::vector<int64_t> event_times{};
+};
+
+/**
+ * @brief Episode recorder
+ *
+ * @details The recorder samples the latest joint states of any number of arms on a common clock
+ *   and writes them into a columnar, chunked episode file. Since the states are taken from state
+ *   monitors, recording adds no driver calls and does not slow down the control of the arms. The
+ *   rows are collected into chunks by the sampling thread, and the chunks are serialized,
+ *   compressed, and written by a separate writer thread.
+ *
+ *   External events, e.g., camera frames, are recorded with mark() on the same steady clock, so
+ *   they can be aligned with the rows after recording.
+ *
+ *   An episode file starts with the magic "TAEPISOD", the version, the number of arms, the number
+ *   of joints of every arm, and the period in ns, followed by blocks. Every block starts with its
+ *   type, compression, number of rows, raw size, and stored size. A states block stores the columns
+ *   one after the other: the common clock time, then for every arm the sample sequence, the sample
+ *   time, and the positions, velocities, efforts, and external efforts in row-major order. An
+ *   events block stores the stream, index, and time columns. Times are steady_clock nanoseconds.
+ *   Blocks are compressed with zlib if TROSSEN_ARM_RECORDER_ZLIB is defined, which requires
+ *   linking with zlib.
+ *
+ *   If reading the states of an arm or writing fails, recording stops after writing the rows
+ *   collected so far, and the exception is rethrown by the next call to stop() or get_rows().
+ */
+class EpisodeRecorder
+{
+public:
+  /**
+   * @brief Construct the episode recorder and write the file header
+   *
+   * @param monitors State monitors of the arms, which must outlive the recorder
+   * @param path Path of the episode file, which is overwritten
+   * @param options Options of the episode recorder
+   */
+  EpisodeRecorder(
+    std::vector<StateMonitor *> monitors,
+    const std::string & path,
+    EpisodeRecorderOptions options = {})
+  : monitors_(std::move(monitors)),
+    options_(std::move(options))
+  {
+    if (monitors_.empty()) {
+      TALOG_FATAL("Episode recorder requires at least one state monitor");
+    }
+    if (options_.period.count() <= 0 || options_.chunk_rows == 0) {
+      TALOG_FATAL("Invalid episode recorder period or chunk rows: expected positive");
+    }
+    for (StateMonitor * monitor : monitors_) {
+      uint8_t num_joints = monitor->get_driver().get_num_joints();
+      if (num_joints == 0) {
+        TALOG_FATAL("Episode recorder requires configured drivers");
+      }
+      num_joints_.push_back(num_joints);
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+      TALOG_FATAL("Failed to open %s: %s", path.c_str(), std::strerror(errno));
+    }
+    uint32_t num_arms = static_cast<uint32_t>(monitors_.size());
+    int64_t period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      options_.period).count();
+    // Flush the header so that a full disk fails here rather than in a corrupt episode
+    if (std::fwrite(detail::EPISODE_MAGIC, sizeof(detail::EPISODE_MAGIC), 1, file_) != 1 ||
+      std::fwrite(&detail::EPISODE_VERSION, sizeof(detail::EPISODE_VERSION), 1, file_) != 1 ||
+      std::fwrite(&num_arms, sizeof(num_arms), 1, file_) != 1 ||
+      std::fwrite(num_joints_.data(), sizeof(uint8_t), num_joints_.size(), file_) !=
+      num_joints_.size() ||
+      std::fwrite(&period, sizeof(period), 1, file_) != 1 ||
+      std::fflush(file_) != 0)
+    {
+      int error = errno;
+      std::fclose(file_);
+      file_ = nullptr;
+      std::remove(path.c_str());
+      TALOG_FATAL(
+        "Failed to write the episode header to %s: %s", path.c_str(), std::strerror(error));
+    }
+  }
+
+  /// @brief Stop recording, flush, and close the episode file
+  ~EpisodeRecorder()
+  {
+    try {
+      stop();
+    } catch (const std::exception & e) {
+      TALOG_ERROR("Episode recording failed: %s", e.what());
+    }
+    std::fclose(file_);
+  }
+
+  EpisodeRecorder(const EpisodeRecorder &) = delete;
+  EpisodeRecorder & operator=(const EpisodeRecorder &) = delete;
+
+  /// @brief Start recording
+  void start()
+  {
+    if (sampling_thread_.joinable()) {
+      TALOG_WARN("Episode recording already started");
+      return;
+    }
+    sampling_ = true;
+    writing_ = true;
+    writer_thread_ = std::thread(&EpisodeRecorder::write, this);
+    sampling_thread_ = std::thread(&EpisodeRecorder::sample, this);
+  }
+
+  /// @brief Stop recording and write the remaining rows and events
+  void stop()
+  {
+    sampling_ = false;
+    if (sampling_thread_.joinable()) {
+      sampling_thread_.join();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_queue_);
+      writing_ = false;
+    }
+    cv_queue_.notify_all();
+    if (writer_thread_.joinable()) {
+      writer_thread_.join();
+    }
+    std::fflush(file_);
+    std::exception_ptr exception_ptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_queue_);
+      std::swap(exception_ptr, exception_ptr_);
+    }
+    if (exception_ptr) {
+      std::rethrow_exception(exception_ptr);
+    }
+  }
+
+  /**
+   * @brief Record an external event, e.g., a camera frame
+   *
+   * @param stream Stream of the event, e.g., the camera index
+   * @param index Index of the event, e.g., the frame index
+   * @param time Optional: time of the event, e.g., the capture time, default now
+   */
+  void mark(
+    uint32_t stream,
+    uint64_t index,
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now())
+  {
+    std::lock_guard<std::mutex> lock(mutex_events_);
+    event_streams_.push_back(stream);
+    event_indices_.push_back(index);
+    event_times_.push_back(to_ns(time));
+  }
+
+  /**
+   * @brief Get the number of recorded rows
+   *
+   * @return Number of rows sampled so far
+   */
+  uint64_t get_rows() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_queue_);
+    if (exception_ptr_) {
+      std::rethrow_exception(exception_ptr_);
+    }
+    return rows_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Rows of the current chunk
+  struct Chunk
+  {
+    std::vector<int64_t> time;
+    std::vector<EpisodeArmData> arms;
+  };
+
+  // Serialized block waiting for the writer
+  struct Block
+  {
+    detail::EpisodeBlock type;
+    uint64_t num_rows;
+    std::vector<uint8_t> bytes;
+  };
+
+  // State monitors of the arms
+  std::vector<StateMonitor *> monitors_;
+
+  // Options
+  EpisodeRecorderOptions options_;
+
+  // Number of joints of the arms
+  std::vector<uint8_t> num_joints_;
+
+  // Episode file
+  std::FILE * file_{nullptr};
+
+  // Number of recorded rows
+  std::atomic<uint64_t> rows_{0};
+
+  // External events not written yet
+  std::vector<uint32_t> event_streams_;
+  std::vector<uint64_t> event_indices_;
+  std::vector<int64_t> event_times_;
+
+  // Mutex for the events
+  std::mutex mutex_events_;
+
+  // Blocks waiting for the writer
+  std::deque<Block> queue_;
+
+  // Mutex for the queue, the writer flag, and the exception
+  mutable std::mutex mutex_queue_;
+
+  // Condition variable signalling a new block or stopping
+  std::condition_variable cv_queue_;
+
+  // Flag for maintaining and stopping the sampling thread
+  std::atomic<bool> sampling_{false};
+
+  // Flag for maintaining and stopping the writer thread
+  bool writing_{false};
+
+  // First exception thrown by the sampling or the writer thread if any
+  std::exception_ptr exception_ptr_;
+
+  // Sampling thread
+  std::thread sampling_thread_;
+
+  // Writer thread
+  std::thread writer_thread_;
+
+  // Nanoseconds since the steady_clock epoch
+  static int64_t to_ns(std::chrono::steady_clock::time_point time)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+  }
+
+  // Store the first exception and stop sampling
+  void fail(std::exception_ptr exception_ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_queue_);
+    if (!exception_ptr_) {
+      exception_ptr_ = exception_ptr;
+    }
+    sampling_ = false;
+  }
+
+  // Create an empty chunk with the columns reserved for a full chunk
+  Chunk make_chunk() const
+  {
+    Chunk chunk;
+    chunk.time.reserve(options_.chunk_rows);
+    for (uint8_t num_joints : num_joints_) {
+      EpisodeArmData arm;
+      arm.num_joints = num_joints;
+      arm.sequence.reserve(options_.chunk_rows);
+      arm.time.reserve(options_.chunk_rows);
+      arm.positions.reserve(options_.chunk_rows * num_joints);
+      arm.velocities.reserve(options_.chunk_rows * num_joints);
+      arm.efforts.reserve(options_.chunk_rows * num_joints);
+      arm.external_efforts.reserve(options_.chunk_rows * num_joints);
+      chunk.arms.push_back(std::move(arm));
+    }
+    return chunk;
+  }
+
+  // Queue the rows of a chunk and the pending events for the writer
+  void flush(Chunk & chunk)
+  {
+    std::vector<Block> blocks;
+    if (!chunk.time.empty()) {
+      Block block{detail::EpisodeBlock::states, chunk.time.size(), {}};
+      detail::append_column(block.bytes, chunk.time);
+      for (const EpisodeArmData & arm : chunk.arms) {
+        detail::append_column(block.bytes, arm.sequence);
+        detail::append_column(block.bytes, arm.time);
+        detail::append_column(block.bytes, arm.positions);
+        detail::append_column(block.bytes, arm.velocities);
+        detail::append_column(block.bytes, arm.efforts);
+        detail::append_column(block.bytes, arm.external_efforts);
+      }
+      blocks.push_back(std::move(block));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_events_);
+      if (!event_times_.empty()) {
+        Block block{detail::EpisodeBlock::events, event_times_.size(), {}};
+        detail::append_column(block.bytes, event_streams_);
+        detail::append_column(block.bytes, event_indices_);
+        detail::append_column(block.bytes, event_times_);
+        event_streams_.clear();
+        event_indices_.clear();
+        event_times_.clear();
+        blocks.push_back(std::move(block));
+      }
+    }
+    if (!blocks.empty()) {
+      std::lock_guard<std::mutex> lock(mutex_queue_);
+      for (Block & block : blocks) {
+        queue_.push_back(std::move(block));
+      }
+    }
+    cv_queue_.notify_one();
+  }
+
+  // Function to be executed by the sampling thread
+  void sample()
+  {
+    Chunk chunk = make_chunk();
+    auto append = [](std::vector<float> & column, const std::vector<float> & values, size_t size) {
+        column.insert(column.end(), values.begin(), values.begin() + std::min(values.size(), size));
+        column.resize(column.size() + size - std::min(values.size(), size), 0.0f);
+      };
+
+    std::vector<JointStates> row(monitors_.size());
+    auto next = std::chrono::steady_clock::now();
+    while (sampling_) {
+      // Read all arms before appending so that a failure leaves no partial row
+      try {
+        for (size_t i = 0; i < monitors_.size(); ++i) {
+          row[i] = monitors_[i]->get_states();
+        }
+      } catch (...) {
+        fail(std::current_exception());
+        break;
+      }
+      chunk.time.push_back(to_ns(next));
+      for (size_t i = 0; i < monitors_.size(); ++i) {
+        const JointStates & states = row[i];
+        EpisodeArmData & arm = chunk.arms[i];
+        arm.sequence.push_back(states.sequence);
+        arm.time.push_back(to_ns(states.time));
+        append(arm.positions, states.positions, arm.num_joints);
+        append(arm.velocities, states.velocities, arm.num_joints);
+        append(arm.efforts, states.efforts, arm.num_joints);
+        append(arm.external_efforts, states.external_efforts, arm.num_joints);
+      }
+      rows_.fetch_add(1, std::memory_order_relaxed);
+      if (chunk.time.size() >= options_.chunk_rows) {
+        flush(chunk);
+        chunk = make_chunk();
+      }
+
+      next += options_.period;
+      auto now = std::chrono::steady_clock::now();
+      if (next < now) {
+        // Do not try to catch up after a long tick
+        next = now;
+      } else {
+        std::this_thread::sleep_until(next);
+      }
+    }
+    flush(chunk);
+  }
+
+  // Compress and write a block
+  void write_block(const Block & block)
+  {
+    detail::EpisodeBlockHeader header{};
+    header.type = static_cast<uint32_t>(block.type);
+    header.num_rows = block.num_rows;
+    header.raw_size = block.bytes.size();
+    const std::vector<uint8_t> * stored = &block.bytes;
+#ifdef TROSSEN_ARM_RECORDER_ZLIB
+    std::vector<uint8_t> compressed(compressBound(block.bytes.size()));
+    uLongf compressed_size = compressed.size();
+    if (compress2(
+        compressed.data(), &compressed_size, block.bytes.data(), block.bytes.size(),
+        options_.compression_level) != Z_OK)
+    {
+      throw std::runtime_error("Failed to compress an episode block");
+    }
+    compressed.resize(compressed_size);
+    header.compression = static_cast<uint32_t>(detail::EpisodeCompression::zlib);
+    stored = &compressed;
+#else
+    header.compression = static_cast<uint32_t>(detail::EpisodeCompression::none);
+#endif
+    header.stored_size = stored->size();
+    if (std::fwrite(&header, sizeof(header), 1, file_) != 1 ||
+      std::fwrite(stored->data(), 1, stored->size(), file_) != stored->size())
+    {
+      throw std::runtime_error(std::string("Failed to write an episode block: ") +
+              std::strerror(errno));
+    }
+  }
+
+  // Function to be executed by the writer thread
+  void write()
+  {
+    std::unique_lock<std::mutex> lock(mutex_queue_);
+    while (true) {
+      cv_queue_.wait(lock, [this] {return !writing_ || !queue_.empty();});
+      if (queue_.empty()) {
+        break;
+      }
+      Block block = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      try {
+        write_block(block);
+      } catch (...) {
+        fail(std::current_exception());
+        lock.lock();
+        queue_.clear();
+        break;
+      }
+      lock.lock();
+    }
+  }
+};
+
+/**
+ * @brief Read an episode file
+ *
+ * @param path Path of the episode file
+ * @return The recorded episode
+ */
+inline EpisodeData read_episode(const std::string & path)
+{
+  std::FILE * file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    TALOG_FATAL("Failed to open %s: %s", path.c_str(), std::strerror(errno));
+  }
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> closer(file, &std::fclose);
+
+  // The file is untrusted, so every size read from it is checked against the remaining bytes
+  // before allocating
+  std::fseek(file, 0, SEEK_END);
+  long file_size = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  auto remaining = [&]() -> uint64_t {
+      long position = std::ftell(file);
+      return position < 0 || file_size < position ? 0 : static_cast<uint64_t>(file_size - position);
+    };
+
+  char magic[sizeof(detail::EPISODE_MAGIC)];
+  uint32_t version = 0;
+  uint32_t num_arms = 0;
+  if (std::fread(magic, sizeof(magic), 1, file) != 1 ||
+    std::memcmp(magic, detail::EPISODE_MAGIC, sizeof(magic)) != 0 ||
+    std::fread(&version, sizeof(version), 1, file) != 1 ||
+    version != detail::EPISODE_VERSION ||
+    std::fread(&num_arms, sizeof(num_arms), 1, file) != 1)
+  {
+    TALOG_FATAL("%s is not a compatible episode file", path.c_str());
+  }
+  if (num_arms > remaining()) {
+    TALOG_FATAL("Truncated episode file %s", path.c_str());
+  }
+  EpisodeData data;
+  data.arms.resize(num_arms);
+  for (EpisodeArmData & arm : data.arms) {
+    if (std::fread(&arm.num_joints, sizeof(arm.num_joints), 1, file) != 1) {
+      TALOG_FATAL("Truncated episode file %s", path.c_str());
+    }
+  }
+  if (std::fread(&data.period, sizeof(data.period), 1, file) != 1) {
+    TALOG_FATAL("Truncated episode file %s", path.c_str());
+  }
+
+  detail::EpisodeBlockHeader header;
+  std::vector<uint8_t> stored;
+  std::vector<uint8_t> block;
+  while (std::fread(&header, sizeof(header), 1, file) == 1) {
+    if (header.stored_size > remaining()) {
+      TALOG_FATAL("Truncated episode file %s", path.c_str());
+    }
+    stored.resize(header.stored_size);
+    if (std::fread(stored.data(), 1, stored.size(), file) != stored.size()) {
+      TALOG_FATAL("Truncated episode file %s", path.c_str());
+    }
+    auto compression = static_cast<detail::EpisodeCompression>(header.compression);
+    if (compression == detail::EpisodeCompression::none) {
+      if (header.raw_size != header.stored_size) {
+        TALOG_FATAL("Corrupted episode block in %s", path.c_str());
+      }
+      block.swap(stored);
+    } else if (compression == detail::EpisodeCompression::zlib) {
+#ifdef TROSSEN_ARM_RECORDER_ZLIB
+      // zlib cannot compress by more than a factor of 1032
+      if (header.raw_size / 1032 > header.stored_size) {
+        TALOG_FATAL("Corrupted episode block in %s", path.c_str());
+      }
+      block.resize(header.raw_size);
+      uLongf raw_size = block.size();
+      if (uncompress(block.data(), &raw_size, stored.data(), stored.size()) != Z_OK ||
+        raw_size != header.raw_size)
+      {
+        TALOG_FATAL("Corrupted episode block in %s", path.c_str());
+      }
+#else
+      TALOG_FATAL("%s is compressed, define TROSSEN_ARM_RECORDER_ZLIB to read it", path.c_str());
+#endif
+    } else {
+      TALOG_FATAL("Unknown episode block compression in %s", path.c_str());
+    }
+
+    size_t offset = 0;
+    size_t rows = header.num_rows;
+    try {
+      switch (static_cast<detail::EpisodeBlock>(header.type)) {
+        case detail::EpisodeBlock::states:
+          detail::read_column(block, offset, rows, data.time);
+          for (EpisodeArmData & arm : data.arms) {
+            detail::read_column(block, offset, rows, arm.sequence);
+            detail::read_column(block, offset, rows, arm.time);
+            detail::read_column(block, offset, rows * arm.num_joints, arm.positions);
+            detail::read_column(block, offset, rows * arm.num_joints, arm.velocities);
+            detail::read_column(block, offset, rows * arm.num_joints, arm.efforts);
+            detail::read_column(block, offset, rows * arm.num_joints, arm.external_efforts);
+          }
+          break;
+        case detail::EpisodeBlock::events:
+          detail::read_column(block, offset, rows, data.event_streams);
+          detail::read_column(block, offset, rows, data.event_indices);
+          detail::read_column(block, offset, rows, data.event_times);
+          break;
+        default:
+          // Skip unknown blocks for forward compatibility
+          break;
+      }
+    } catch (const std::runtime_error &) {
+      TALOG_FATAL("Corrupted episode block in %s", path.c_str());
+    }
+  }
+  return data;
+}
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_RECORDER_HPP_
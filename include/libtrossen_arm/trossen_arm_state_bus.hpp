@@ -0,0 +1,494 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_STATE_BUS_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_STATE_BUS_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_monitor.hpp"
+
+namespace trossen_arm
+{
+
+namespace detail
+{
+
+// Maximum number of joints supported by the shared-memory layouts
+constexpr uint8_t SHM_MAX_JOINTS{16};
+
+// Joint states as laid out in shared memory
+struct ShmJointStates
+{
+  uint64_t sequence;
+  int64_t time_ns;
+  float positions[SHM_MAX_JOINTS];
+  float velocities[SHM_MAX_JOINTS];
+  float efforts[SHM_MAX_JOINTS];
+  float external_efforts[SHM_MAX_JOINTS];
+};
+
+// Joint commands as laid out in shared memory
+struct ShmJointCommands
+{
+  uint64_t sequence;
+  int64_t time_ns;
+  Mode modes[SHM_MAX_JOINTS];
+  float values[SHM_MAX_JOINTS];
+  float feedforward_velocities[SHM_MAX_JOINTS];
+  float feedforward_accelerations[SHM_MAX_JOINTS];
+};
+
+// Slot guarded by a sequence lock, odd while being written
+template<typename T>
+struct alignas(64) SeqlockSlot
+{
+  std::atomic<uint64_t> seq;
+  T data;
+};
+
+// Header of a state bus, followed by the ring of state slots
+struct ShmStateBusHeader
+{
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t num_joints;
+  uint32_t capacity;
+  alignas(64) std::atomic<uint64_t> write_index;
+  SeqlockSlot<ShmJointCommands> commands;
+};
+
+// Magic number identifying a state bus
+constexpr uint32_t STATE_BUS_MAGIC{0x54415342};
+
+// Version of the state bus layout
+constexpr uint32_t STATE_BUS_VERSION{1};
+
+// Write a slot, only one writer is allowed
+template<typename T>
+void seqlock_write(SeqlockSlot<T> & slot, const T & data)
+{
+  uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&slot.data, &data, sizeof(T));
+  slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+// Read a slot consistently, return false if the writer kept interfering
+template<typename T>
+bool seqlock_read(const SeqlockSlot<T> & slot, T & data, int max_retries = 64)
+{
+  for (int i = 0; i < max_retries; ++i) {
+    uint64_t begin = slot.seq.load(std::memory_order_acquire);
+    if (begin & 1) {
+      continue;
+    }
+    std::memcpy(&data, &slot.data, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) == begin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Nanoseconds since the steady_clock epoch, CLOCK_MONOTONIC on Linux and shared by processes
+inline int64_t to_ns(std::chrono::steady_clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Publisher of the driver state to a POSIX shared-memory bus
+ *
+ * @details The publisher subscribes to a state monitor and writes every sample into a ring of
+ *   slots in shared memory, each guarded by a sequence lock, so that any number of other processes
+ *   can map the bus read-only and read the states without locks and without slowing down the
+ *   publisher. Commanded inputs can be published alongside, either directly or by passing the
+ *   publisher to CommandArbiter, JointMailbox, or CommandStreamer, which then publish every set of
+ *   commands they apply.
+ *
+ *   The shared memory object /dev/shm/<name> is created by the publisher and removed at its
+ *   destruction. Creation fails if the object already exists, e.g., because another publisher
+ *   uses the name, unless replacing it is requested, e.g., after a publisher crashed.
+ */
+class StateBusPublisher
+{
+public:
+  /**
+   * @brief Construct the publisher, create the bus, and subscribe to the state monitor
+   *
+   * @param monitor A state monitor, which must outlive the publisher
+   * @param name Name of the shared memory object, starting with a slash, e.g., /trossen_arm_1
+   * @param capacity Optional: number of slots in the ring, default 1024
+   * @param replace Optional: whether to remove an existing shared memory object of the same name
+   *   first, default false
+   */
+  StateBusPublisher(
+    StateMonitor & monitor,
+    const std::string & name,
+    uint32_t capacity = 1024,
+    bool replace = false)
+  : monitor_(monitor),
+    name_(name),
+    size_(sizeof(Header) + capacity * sizeof(detail::SeqlockSlot<detail::ShmJointStates>))
+  {
+    num_joints_ = monitor_.get_driver().get_num_joints();
+    if (num_joints_ == 0 || num_joints_ > detail::SHM_MAX_JOINTS) {
+      TALOG_FATAL(
+        "Invalid number of joints for the state bus: expected within [1, %d], got %d",
+        detail::SHM_MAX_JOINTS, num_joints_);
+    }
+    if (capacity == 0) {
+      TALOG_FATAL("Invalid state bus capacity: expected positive, got 0");
+    }
+    if (replace) {
+      shm_unlink(name_.c_str());
+    }
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+      TALOG_FATAL("Failed to create the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    if (ftruncate(fd, size_) < 0) {
+      close(fd);
+      shm_unlink(name_.c_str());
+      TALOG_FATAL("Failed to size the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    void * address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+      shm_unlink(name_.c_str());
+      TALOG_FATAL("Failed to map the shared memory %s: %s", name_.c_str(), std::strerror(errno));
+    }
+    header_ = new (address) Header{};
+    header_->num_joints = num_joints_;
+    header_->capacity = capacity;
+    header_->version = detail::STATE_BUS_VERSION;
+    slots_ = reinterpret_cast<detail::SeqlockSlot<detail::ShmJointStates> *>(header_ + 1);
+    // Publish the magic last so that readers never see a partially initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic.store(detail::STATE_BUS_MAGIC, std::memory_order_release);
+
+    subscription_ = monitor_.subscribe(
+      [this](const JointStates & states) {publish(states);});
+  }
+
+  /// @brief Unsubscribe from the state monitor and remove the bus
+  ~StateBusPublisher()
+  {
+    monitor_.unsubscribe(subscription_);
+    munmap(header_, size_);
+    shm_unlink(name_.c_str());
+  }
+
+  StateBusPublisher(const StateBusPublisher &) = delete;
+  StateBusPublisher & operator=(const StateBusPublisher &) = delete;
+
+  /**
+   * @brief Publish the commanded inputs
+   *
+   * @param commands Commands of all joints
+   *
+   * @note Commands may be published from several threads, the last published ones are kept
+   */
+  void publish_commands(const std::vector<JointCommand> & commands)
+  {
+    std::lock_guard<std::mutex> lock(mutex_commands_);
+    detail::ShmJointCommands data{};
+    data.sequence = ++command_sequence_;
+    data.time_ns = detail::to_ns(std::chrono::steady_clock::now());
+    for (size_t i = 0; i < std::min<size_t>(commands.size(), num_joints_); ++i) {
+      data.modes[i] = commands[i].mode;
+      data.values[i] = commands[i].value;
+      data.feedforward_velocities[i] = commands[i].feedforward_velocity;
+      data.feedforward_accelerations[i] = commands[i].feedforward_acceleration;
+    }
+    detail::seqlock_write(header_->commands, data);
+  }
+
+private:
+  // State monitor providing the samples
+  StateMonitor & monitor_;
+
+  // Name of the shared memory object
+  std::string name_;
+
+  // Size of the mapping in bytes
+  size_t size_;
+
+  using Header = detail::ShmStateBusHeader;
+
+  // Number of joints
+  uint8_t num_joints_{0};
+
+  // Mapped header
+  Header * header_{nullptr};
+
+  // Mapped ring of state slots
+  detail::SeqlockSlot<detail::ShmJointStates> * slots_{nullptr};
+
+  // Sequence number of the last published commands
+  uint64_t command_sequence_{0};
+
+  // Mutex serializing the writers of the commands slot
+  std::mutex mutex_commands_;
+
+  // Identifier of the subscription to the state monitor
+  size_t subscription_{0};
+
+  // Write a sample into the next slot, called on the monitor thread
+  void publish(const JointStates & states)
+  {
+    detail::ShmJointStates data{};
+    data.sequence = states.sequence;
+    data.time_ns = detail::to_ns(states.time);
+    auto copy = [&](const std::vector<float> & from, float * to) {
+        std::copy_n(from.begin(), std::min<size_t>(from.size(), num_joints_), to);
+      };
+    copy(states.positions, data.positions);
+    copy(states.velocities, data.velocities);
+    copy(states.efforts, data.efforts);
+    copy(states.external_efforts, data.external_efforts);
+
+    uint64_t index = header_->write_index.load(std::memory_order_relaxed);
+    detail::seqlock_write(slots_[index % header_->capacity], data);
+    header_->write_index.store(index + 1, std::memory_order_release);
+  }
+};
+
+/**
+ * @brief Read-only reader of a state bus
+ *
+ * @details The reader maps the bus read-only, so it can neither disturb the publisher nor other
+ *   readers. Reads are lock-free and retry only while the slot being read is written. The layout
+ *   given by the header is checked against the size of the mapping once and cached, so a corrupt
+ *   or foreign object cannot make the reader index past the mapping.
+ */
+class StateBusReader
+{
+public:
+  /**
+   * @brief Construct the reader and map the bus
+   *
+   * @param name Name of the shared memory object given to the publisher
+   */
+  explicit StateBusReader(const std::string & name)
+  : name_(name)
+  {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      TALOG_FATAL("Failed to open the shared memory %s: %s", name.c_str(), std::strerror(errno));
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0) {
+      st.st_size = 0;
+    }
+    size_ = st.st_size;
+    void * address = size_ >= sizeof(Header) ?
+      mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (address == MAP_FAILED) {
+      TALOG_FATAL("Failed to map the shared memory %s", name.c_str());
+    }
+    header_ = static_cast<const Header *>(address);
+    if (header_->magic.load(std::memory_order_acquire) != detail::STATE_BUS_MAGIC ||
+      header_->version != detail::STATE_BUS_VERSION)
+    {
+      munmap(const_cast<Header *>(header_), size_);
+      TALOG_FATAL("Shared memory %s is not a compatible state bus", name.c_str());
+    }
+    num_joints_ = header_->num_joints;
+    capacity_ = header_->capacity;
+    if (num_joints_ == 0 || num_joints_ > detail::SHM_MAX_JOINTS || capacity_ == 0 ||
+      (size_ - sizeof(Header)) / sizeof(detail::SeqlockSlot<detail::ShmJointStates>) < capacity_)
+    {
+      munmap(const_cast<Header *>(header_), size_);
+      TALOG_FATAL(
+        "Shared memory %s of %zu bytes is too small for a state bus of %u slots and %u joints",
+        name.c_str(), size_, capacity_, num_joints_);
+    }
+    slots_ = reinterpret_cast<const detail::SeqlockSlot<detail::ShmJointStates> *>(header_ + 1);
+  }
+
+  /// @brief Unmap the bus and destroy the reader
+  ~StateBusReader()
+  {
+    munmap(const_cast<Header *>(header_), size_);
+  }
+
+  StateBusReader(const StateBusReader &) = delete;
+  StateBusReader & operator=(const StateBusReader &) = delete;
+
+  /**
+   * @brief Get the number of joints
+   *
+   * @return Number of joints
+   */
+  uint8_t get_num_joints() const
+  {
+    return static_cast<uint8_t>(num_joints_);
+  }
+
+  /**
+   * @brief Get the number of samples published so far
+   *
+   * @return Number of published samples, the index of the next one
+   */
+  uint64_t get_write_index() const
+  {
+    return header_->write_index.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Read a sample
+   *
+   * @param index Index of the sample in [get_write_index() - capacity, get_write_index() - 1]
+   * @param states The joint states to fill, only the sequence, time, and the joint fields are set
+   * @return true The sample was read
+   * @return false The sample is not available or was overwritten while reading
+   */
+  bool read(uint64_t index, JointStates & states) const
+  {
+    uint64_t write_index = get_write_index();
+    if (index >= write_index || write_index - index > capacity_) {
+      return false;
+    }
+    detail::ShmJointStates data;
+    if (!detail::seqlock_read(slots_[index % capacity_], data)) {
+      return false;
+    }
+    // The slot may have been reused for a newer sample after the index check
+    if (get_write_index() - index > capacity_) {
+      return false;
+    }
+    uint8_t num_joints = get_num_joints();
+    states.sequence = data.sequence;
+    states.time = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(data.time_ns));
+    states.positions.assign(data.positions, data.positions + num_joints);
+    states.velocities.assign(data.velocities, data.velocities + num_joints);
+    states.efforts.assign(data.efforts, data.efforts + num_joints);
+    states.external_efforts.assign(data.external_efforts, data.external_efforts + num_joints);
+    return true;
+  }
+
+  /**
+   * @brief Read the latest sample
+   *
+   * @param states The joint states to fill
+   * @param max_attempts Optional: number of attempts before giving up, default 1000
+   * @return true The latest sample was read
+   * @return false No sample has been published yet
+   *
+   * @details Throws if every attempt finds the slot being written, e.g., because the publisher
+   *   died in the middle of a write.
+   */
+  bool read_latest(JointStates & states, int max_attempts = 1000) const
+  {
+    for (int i = 0; i < max_attempts; ++i) {
+      uint64_t write_index = get_write_index();
+      if (write_index == 0) {
+        return false;
+      }
+      if (read(write_index - 1, states)) {
+        return true;
+      }
+    }
+    TALOG_FATAL(
+      "Failed to read the latest sample of the state bus %s after %d attempts",
+      name_.c_str(), max_attempts);
+    return false;
+  }
+
+  /**
+   * @brief Read the latest commanded inputs
+   *
+   * @param commands The commands to fill
+   * @return true Commands were read
+   * @return false No commands have been published yet or the publisher kept writing them while
+   *   reading, in which case a later call may succeed
+   */
+  bool read_commands(std::vector<JointCommand> & commands) const
+  {
+    detail::ShmJointCommands data;
+    if (!detail::seqlock_read(header_->commands, data) || data.sequence == 0) {
+      return false;
+    }
+    commands.resize(get_num_joints());
+    for (size_t i = 0; i < commands.size(); ++i) {
+      commands[i].mode = data.modes[i];
+      commands[i].value = data.values[i];
+      commands[i].feedforward_velocity = data.feedforward_velocities[i];
+      commands[i].feedforward_acceleration = data.feedforward_accelerations[i];
+    }
+    return true;
+  }
+
+private:
+  using Header = detail::ShmStateBusHeader;
+
+  // Name of the shared memory object
+  std::string name_;
+
+  // Size of the mapping in bytes
+  size_t size_{0};
+
+  // Number of joints, cached from the header
+  uint32_t num_joints_{0};
+
+  // Number of slots in the ring, cached from the header
+  uint32_t capacity_{0};
+
+  // Mapped header
+  const Header * header_{nullptr};
+
+  // Mapped ring of state slots
+  const detail::SeqlockSlot<detail::ShmJointStates> * slots_{nullptr};
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_STATE_BUS_HPP_
@@ -0,0 +1,354 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_STREAMING_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_STREAMING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_control.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+#include "libtrossen_arm/trossen_arm_state_bus.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief Chunk of commands executed by the command streamer
+struct CommandChunk
+{
+  /// @brief Commands of all joints at every step in row-major order, i.e., num_steps rows of
+  /// num_joints values
+  std::vector<float> values{};
+
+  /// @brief Number of steps
+  size_t num_steps{0};
+
+  /// @brief Time between two steps
+  std::chrono::nanoseconds timestep{0};
+
+  /// @brief Time of the first step
+  std::chrono::steady_clock::time_point origin{};
+};
+
+/**
+ * @brief Command streamer
+ *
+ * @details The streamer executes chunks of commands, e.g., the action chunks of a learned policy,
+ *   from its own thread on its own clock, so the caller only submits a chunk whenever it has one
+ *   and does no per-step timing. At every timestep, the streamer applies the commands of the
+ *   current step in the configured modes without blocking. In the position mode, the difference to
+ *   the next step is commanded as the feedforward velocity.
+ *
+ *   Submitting a chunk atomically replaces the remainder of the current one, and the first due step
+ *   of the new chunk is applied right away. Steps whose time has passed when the chunk arrives,
+ *   e.g., because of the inference latency when the origin is the time of the observation, are
+ *   skipped. Whenever the applied step does not directly follow the previous one, i.e., at the
+ *   first step of a chunk and after skipped steps, it is blended in from the current commands over
+ *   one timestep instead of being applied as an immediate goal, which would make the joints jump.
+ *   After the last step, the driver holds the last commands until the next chunk.
+ *
+ *   If a driver call throws, the streamer stops and the exception is rethrown by the next call to
+ *   submit() or stop().
+ */
+class CommandStreamer
+{
+public:
+  /**
+   * @brief Construct the command streamer
+   *
+   * @param driver A configured driver, which must outlive the streamer
+   * @param bus Optional: state bus publishing the applied commands, which must outlive the
+   *   streamer, none by default
+   */
+  explicit CommandStreamer(TrossenArmDriver & driver, StateBusPublisher * bus = nullptr)
+  : driver_(driver),
+    bus_(bus)
+  {
+    num_joints_ = driver_.get_num_joints();
+    if (num_joints_ == 0) {
+      TALOG_FATAL("Command streamer requires a configured driver");
+    }
+  }
+
+  /// @brief Stop streaming and destroy the command streamer
+  ~CommandStreamer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      activated_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  CommandStreamer(const CommandStreamer &) = delete;
+  CommandStreamer & operator=(const CommandStreamer &) = delete;
+
+  /// @brief Start streaming with the modes configured at this time
+  void start()
+  {
+    if (thread_.joinable()) {
+      TALOG_WARN("Command streamer already started");
+      return;
+    }
+    modes_ = driver_.get_modes();
+    activated_ = true;
+    thread_ = std::thread(&CommandStreamer::run, this);
+  }
+
+  /// @brief Stop streaming, the driver holds the last commands
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      activated_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    rethrow_if_failed();
+  }
+
+  /**
+   * @brief Submit a chunk, replacing the remainder of the current one
+   *
+   * @param values Commands of all joints at every step in row-major order, i.e., num_steps rows of
+   *   get_num_joints() values, copied before returning
+   * @param num_steps Number of steps
+   * @param timestep Time between two steps
+   * @param origin Optional: time of the first step, default now
+   */
+  void submit(
+    const float * values,
+    size_t num_steps,
+    std::chrono::nanoseconds timestep,
+    std::optional<std::chrono::steady_clock::time_point> origin = std::nullopt)
+  {
+    if (num_steps == 0) {
+      TALOG_FATAL("Invalid number of steps: expected positive, got 0");
+    }
+    if (timestep.count() <= 0) {
+      TALOG_FATAL(
+        "Invalid timestep: expected positive, got %lld ns",
+        static_cast<long long>(timestep.count()));
+    }
+    auto chunk = std::make_shared<CommandChunk>();
+    chunk->values.assign(values, values + num_steps * num_joints_);
+    chunk->num_steps = num_steps;
+    chunk->timestep = timestep;
+    chunk->origin = origin.value_or(std::chrono::steady_clock::now());
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      rethrow_if_failed();
+      chunk_ = std::move(chunk);
+      ++generation_;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Submit a chunk, replacing the remainder of the current one
+   *
+   * @param values Commands of all joints at every step in row-major order, whose size must be a
+   *   multiple of get_num_joints()
+   * @param timestep Time between two steps
+   * @param origin Optional: time of the first step, default now
+   */
+  void submit(
+    const std::vector<float> & values,
+    std::chrono::nanoseconds timestep,
+    std::optional<std::chrono::steady_clock::time_point> origin = std::nullopt)
+  {
+    if (values.empty() || values.size() % num_joints_ != 0) {
+      TALOG_FATAL(
+        "Invalid chunk size: expected a positive multiple of %d, got %d",
+        num_joints_, static_cast<int>(values.size()));
+    }
+    submit(values.data(), values.size() / num_joints_, timestep, origin);
+  }
+
+  /**
+   * @brief Get the number of joints
+   *
+   * @return Number of joints, the row size of the chunks
+   */
+  uint8_t get_num_joints() const
+  {
+    return num_joints_;
+  }
+
+  /**
+   * @brief Get the number of steps of the current chunk not applied yet
+   *
+   * @return Number of remaining steps, 0 if the chunk is done or there is none
+   */
+  size_t get_remaining_steps() const
+  {
+    return remaining_steps_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Driver to command
+  TrossenArmDriver & driver_;
+
+  // State bus publishing the applied commands if any
+  StateBusPublisher * bus_;
+
+  // Number of joints
+  uint8_t num_joints_{0};
+
+  // Modes of the joints
+  std::vector<Mode> modes_;
+
+  // Current chunk
+  std::shared_ptr<const CommandChunk> chunk_;
+
+  // Number of submitted chunks
+  uint64_t generation_{0};
+
+  // Number of steps of the current chunk not applied yet
+  std::atomic<size_t> remaining_steps_{0};
+
+  // Exception thrown by the driver if any
+  std::exception_ptr exception_ptr_;
+
+  // Mutex for the chunk, the flag, and the exception
+  mutable std::mutex mutex_;
+
+  // Condition variable signalling a new chunk or stopping
+  std::condition_variable cv_;
+
+  // Flag for maintaining and stopping the streaming thread
+  bool activated_{false};
+
+  // Streaming thread
+  std::thread thread_;
+
+  // Rethrow the stored exception
+  void rethrow_if_failed()
+  {
+    if (exception_ptr_) {
+      std::rethrow_exception(exception_ptr_);
+    }
+  }
+
+  // Function to be executed by the streaming thread
+  void run()
+  {
+    std::vector<JointCommand> commands(num_joints_);
+    for (uint8_t i = 0; i < num_joints_; ++i) {
+      commands[i].mode = modes_[i];
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::shared_ptr<const CommandChunk> chunk;
+    uint64_t generation = 0;
+    // Index of the next step of the chunk to apply
+    size_t next_step = 0;
+    // Whether the next step directly follows the last applied one
+    bool continuous = false;
+    while (activated_) {
+      if (generation != generation_) {
+        chunk = chunk_;
+        generation = generation_;
+        next_step = 0;
+        continuous = false;
+      }
+      if (!chunk || next_step >= chunk->num_steps) {
+        remaining_steps_.store(0, std::memory_order_relaxed);
+        cv_.wait(lock, [&] {return !activated_ || generation != generation_;});
+        continue;
+      }
+
+      // Skip the steps whose time has passed
+      auto now = std::chrono::steady_clock::now();
+      if (now >= chunk->origin) {
+        size_t due_step = static_cast<size_t>((now - chunk->origin) / chunk->timestep);
+        if (due_step >= chunk->num_steps) {
+          due_step = chunk->num_steps - 1;
+        }
+        if (due_step > next_step) {
+          next_step = due_step;
+          continuous = false;
+        }
+      }
+      auto due = chunk->origin + next_step * chunk->timestep;
+      if (now < due) {
+        cv_.wait_until(lock, due, [&] {return !activated_ || generation != generation_;});
+        continue;
+      }
+
+      const float * row = chunk->values.data() + next_step * num_joints_;
+      const float * next_row = next_step + 1 < chunk->num_steps ? row + num_joints_ : row;
+      float timestep = std::chrono::duration<float>(chunk->timestep).count();
+      for (uint8_t i = 0; i < num_joints_; ++i) {
+        commands[i].value = row[i];
+        if (modes_[i] == Mode::position) {
+          commands[i].feedforward_velocity = (next_row[i] - row[i]) / timestep;
+        }
+      }
+      ++next_step;
+      remaining_steps_.store(chunk->num_steps - next_step, std::memory_order_relaxed);
+      float goal_time = continuous ? 0.0f : timestep;
+      continuous = true;
+
+      lock.unlock();
+      try {
+        apply_commands(driver_, commands, goal_time);
+        if (bus_) {
+          bus_->publish_commands(commands);
+        }
+      } catch (...) {
+        lock.lock();
+        exception_ptr_ = std::current_exception();
+        activated_ = false;
+        break;
+      }
+      lock.lock();
+    }
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_STREAMING_HPP_
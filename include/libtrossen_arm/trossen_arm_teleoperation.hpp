@@ -0,0 +1,357 @@
+// Copyright 2025 Trossen Robotics
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the the copyright holder nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LIBTROSSEN_ARM__TROSSEN_ARM_TELEOPERATION_HPP_
+#define LIBTROSSEN_ARM__TROSSEN_ARM_TELEOPERATION_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libtrossen_arm/trossen_arm.hpp"
+#include "libtrossen_arm/trossen_arm_logging.hpp"
+
+namespace trossen_arm
+{
+
+/// @brief A leader and a follower mirrored by the teleoperation engine
+struct TeleoperationPair
+{
+  /// @brief Leader driver, configured, in the external_effort mode while teleoperating
+  TrossenArmDriver * leader{nullptr};
+
+  /// @brief Follower driver, configured, in the position mode while teleoperating
+  TrossenArmDriver * follower{nullptr};
+
+  /// @brief Index of the leader joint mirrored by each follower joint, identity if empty
+  std::vector<uint8_t> joint_map{};
+
+  /// @brief Scale from the leader joint position to the follower joint position for each follower
+  /// joint, ones if empty
+  std::vector<float> position_scales{};
+
+  /// @brief Gain from the follower joint external effort to the leader joint external effort for
+  /// each follower joint, 0.1 if empty
+  std::vector<float> force_feedback_gains{};
+};
+
+/// @brief Options of the teleoperation engine
+struct TeleoperationOptions
+{
+  /// @brief Period of the teleoperation tick
+  std::chrono::microseconds period{1000};
+
+  /// @brief Whether to set the leaders to the external_effort mode and the followers to the
+  /// position mode at start
+  bool set_modes{true};
+};
+
+/// @brief Mirroring latency of a pair
+struct TeleoperationLatency
+{
+  /// @brief Number of ticks
+  uint64_t ticks{0};
+
+  /// @brief Latency in s of the last tick
+  double last{0.0};
+
+  /// @brief Mean latency in s
+  double mean{0.0};
+
+  /// @brief Maximum latency in s
+  double max{0.0};
+};
+
+/**
+ * @brief Teleoperation engine
+ *
+ * @details The engine mirrors any number of leader-follower pairs on a common tick. At every tick
+ *   and for every pair, it reads the leader positions and velocities and the follower external
+ *   efforts, commands the mapped and scaled positions and velocities to the follower, and commands
+ *   the negated and scaled external efforts back to the leader.
+ *
+ *   Mirroring a pair takes three getter and two setter communication cycles. Every pair is
+ *   therefore mirrored by its own thread, all of them scheduled on the same tick, so adding pairs
+ *   does not delay the others.
+ *
+ *   The mirroring latency is measured from the start of reading the leader to the follower command
+ *   being applied.
+ *
+ *   When the engine stops, either by stop() or because a driver threw, every leader is commanded
+ *   zero external efforts so that no force feedback is left pushing against the operator. The
+ *   exception if any is rethrown by the next call to stop() or get_latency().
+ */
+class TeleoperationEngine
+{
+public:
+  /**
+   * @brief Construct the teleoperation engine
+   *
+   * @param pairs Leader-follower pairs, whose drivers must outlive the engine
+   * @param options Options of the teleoperation engine
+   */
+  explicit TeleoperationEngine(
+    std::vector<TeleoperationPair> pairs,
+    TeleoperationOptions options = {})
+  : pairs_(std::move(pairs)),
+    options_(std::move(options)),
+    latencies_(pairs_.size())
+  {
+    for (TeleoperationPair & pair : pairs_) {
+      if (pair.leader == nullptr || pair.follower == nullptr) {
+        TALOG_FATAL("Teleoperation pair without a leader or a follower");
+      }
+      uint8_t num_leader_joints = pair.leader->get_num_joints();
+      uint8_t num_follower_joints = pair.follower->get_num_joints();
+      if (pair.joint_map.empty()) {
+        if (num_leader_joints != num_follower_joints) {
+          TALOG_FATAL(
+            "Joint map required for %d leader joints and %d follower joints",
+            num_leader_joints, num_follower_joints);
+        }
+        for (uint8_t i = 0; i < num_follower_joints; ++i) {
+          pair.joint_map.push_back(i);
+        }
+      }
+      if (pair.position_scales.empty()) {
+        pair.position_scales.assign(num_follower_joints, 1.0f);
+      }
+      if (pair.force_feedback_gains.empty()) {
+        pair.force_feedback_gains.assign(num_follower_joints, 0.1f);
+      }
+      if (pair.joint_map.size() != num_follower_joints) {
+        TALOG_FATAL(
+          "Invalid joint map size: expected %d, got %d",
+          num_follower_joints, static_cast<int>(pair.joint_map.size()));
+      }
+      if (pair.position_scales.size() != num_follower_joints) {
+        TALOG_FATAL(
+          "Invalid position scales size: expected %d, got %d",
+          num_follower_joints, static_cast<int>(pair.position_scales.size()));
+      }
+      if (pair.force_feedback_gains.size() != num_follower_joints) {
+        TALOG_FATAL(
+          "Invalid force feedback gains size: expected %d, got %d",
+          num_follower_joints, static_cast<int>(pair.force_feedback_gains.size()));
+      }
+      for (uint8_t leader_joint : pair.joint_map) {
+        if (leader_joint >= num_leader_joints) {
+          TALOG_FATAL(
+            "Invalid joint map entry: expected within [0, %d], got %d",
+            num_leader_joints - 1, leader_joint);
+        }
+      }
+    }
+  }
+
+  /// @brief Stop teleoperating and destroy the teleoperation engine
+  ~TeleoperationEngine()
+  {
+    join();
+  }
+
+  TeleoperationEngine(const TeleoperationEngine &) = delete;
+  TeleoperationEngine & operator=(const TeleoperationEngine &) = delete;
+
+  /// @brief Start teleoperating
+  void start()
+  {
+    if (!threads_.empty()) {
+      TALOG_WARN("Teleoperation already started");
+      return;
+    }
+    if (options_.set_modes) {
+      for (TeleoperationPair & pair : pairs_) {
+        pair.leader->set_all_modes(Mode::external_effort);
+        pair.follower->set_all_modes(Mode::position);
+      }
+    }
+    activated_ = true;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pairs_.size(); ++i) {
+      threads_.emplace_back(&TeleoperationEngine::run, this, i, start);
+    }
+  }
+
+  /// @brief Stop teleoperating, the leaders are commanded zero external efforts and the followers
+  /// hold the last positions
+  void stop()
+  {
+    join();
+    std::lock_guard<std::mutex> lock(mutex_latencies_);
+    rethrow_if_failed();
+  }
+
+  /**
+   * @brief Get the mirroring latency of a pair
+   *
+   * @param pair_index The index of the pair
+   * @return The mirroring latency
+   */
+  TeleoperationLatency get_latency(size_t pair_index)
+  {
+    std::lock_guard<std::mutex> lock(mutex_latencies_);
+    rethrow_if_failed();
+    return latencies_.at(pair_index);
+  }
+
+private:
+  // Leader-follower pairs
+  std::vector<TeleoperationPair> pairs_;
+
+  // Options
+  TeleoperationOptions options_;
+
+  // Mirroring latencies of the pairs
+  std::vector<TeleoperationLatency> latencies_;
+
+  // Exception thrown by a driver if any
+  std::exception_ptr exception_ptr_;
+
+  // Mutex for the latencies and the exception
+  std::mutex mutex_latencies_;
+
+  // Atomic flag for maintaining and stopping the teleoperation threads
+  std::atomic<bool> activated_{false};
+
+  // Teleoperation threads, one per pair
+  std::vector<std::thread> threads_;
+
+  // Stop and join the teleoperation threads
+  void join()
+  {
+    activated_ = false;
+    for (std::thread & thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    threads_.clear();
+  }
+
+  // Store the first exception and stop all pairs
+  void fail(std::exception_ptr exception_ptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_latencies_);
+    if (!exception_ptr_) {
+      exception_ptr_ = exception_ptr;
+    }
+    activated_ = false;
+  }
+
+  // Rethrow the stored exception, the caller must hold mutex_latencies_
+  void rethrow_if_failed()
+  {
+    if (exception_ptr_) {
+      std::rethrow_exception(exception_ptr_);
+    }
+  }
+
+  // Mirror a pair and return the mirroring latency in s
+  static double mirror(
+    const TeleoperationPair & pair,
+    std::vector<float> & follower_positions,
+    std::vector<float> & follower_velocities,
+    std::vector<float> & leader_external_efforts)
+  {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<float> leader_positions = pair.leader->get_positions();
+    std::vector<float> leader_velocities = pair.leader->get_velocities();
+    std::vector<float> follower_external_efforts = pair.follower->get_external_efforts();
+
+    leader_external_efforts.assign(leader_positions.size(), 0.0f);
+    for (size_t i = 0; i < pair.joint_map.size(); ++i) {
+      uint8_t j = pair.joint_map[i];
+      follower_positions[i] = pair.position_scales[i] * leader_positions[j];
+      follower_velocities[i] = pair.position_scales[i] * leader_velocities[j];
+      leader_external_efforts[j] += -pair.force_feedback_gains[i] * follower_external_efforts[i];
+    }
+    pair.follower->set_all_positions(follower_positions, 0.0f, false, follower_velocities);
+    auto end = std::chrono::steady_clock::now();
+    pair.leader->set_all_external_efforts(leader_external_efforts, 0.0f, false);
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+  // Function to be executed by the teleoperation thread of a pair
+  void run(size_t pair_index, std::chrono::steady_clock::time_point start)
+  {
+    const TeleoperationPair & pair = pairs_[pair_index];
+    std::vector<float> follower_positions(pair.joint_map.size());
+    std::vector<float> follower_velocities(pair.joint_map.size());
+    std::vector<float> leader_external_efforts;
+
+    auto next = start;
+    while (activated_) {
+      double latency;
+      try {
+        latency = mirror(pair, follower_positions, follower_velocities, leader_external_efforts);
+      } catch (...) {
+        fail(std::current_exception());
+        break;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_latencies_);
+        TeleoperationLatency & stats = latencies_[pair_index];
+        ++stats.ticks;
+        stats.last = latency;
+        stats.mean += (latency - stats.mean) / stats.ticks;
+        if (latency > stats.max) {
+          stats.max = latency;
+        }
+      }
+
+      next += options_.period;
+      auto now = std::chrono::steady_clock::now();
+      if (next < now) {
+        // Skip the missed ticks to stay on the common tick without trying to catch up
+        next += (now - next) / options_.period * options_.period + options_.period;
+      }
+      std::this_thread::sleep_until(next);
+    }
+
+    // Release the leader so that no force feedback is left pushing against the operator
+    try {
+      pair.leader->set_all_external_efforts(
+        std::vector<float>(pair.leader->get_num_joints(), 0.0f), 0.0f, false);
+    } catch (...) {
+      // Log the failure since fail() only keeps the first exception, e.g., the one ending the loop
+      TALOG_ERROR("Failed to release teleoperation leader %d", static_cast<int>(pair_index));
+      fail(std::current_exception());
+    }
+  }
+};
+
+}  // namespace trossen_arm
+
+#endif  // LIBTROSSEN_ARM__TROSSEN_ARM_TELEOPERATION_HPP_